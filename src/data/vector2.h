@@ -95,7 +95,59 @@ Vector2T<T> operator * (const T & s, Vector2T<T> v) { return Vector2T<T>(s * v.x
 template <typename T>
 Vector2T<T> operator * (Vector2T<T> v, const T & s) { return operator*(s, v); }
 
+// Vector2T made of references to two values stored apart, in the columns of a pool
+template <typename T>
+struct Vector2RefT {
+
+    T& x;
+    T& y;
+
+    Vector2RefT(T& x, T& y)
+            : x(x)
+            , y(y)
+    {
+    }
+
+    Vector2RefT& operator = (const Vector2T<T> v)
+    {
+        x = v.x;
+        y = v.y;
+        return *this;
+    }
+
+    Vector2RefT& operator = (const Vector2RefT& v) { return *this = Vector2T<T>(v); }
+
+    operator Vector2T<T>() const { return Vector2T<T>(x, y); }
+
+    Vector2T<T> operator + (const Vector2T<T> rv) const { return Vector2T<T>(x + rv.x, y + rv.y); }
+
+    Vector2T<T> operator - (const Vector2T<T> rv) const { return Vector2T<T>(x - rv.x, y - rv.y); }
+
+    void operator += (const Vector2T<T> rv)
+    {
+        x += rv.x;
+        y += rv.y;
+    }
+
+    void operator -= (const Vector2T<T> rv)
+    {
+        x -= rv.x;
+        y -= rv.y;
+    }
+
+    sf::Vector2<T> operator ()() const {
+        return sf::Vector2<T>(x, y);
+    }
+
+    T sqrMagnitude() const { return Vector2T<T>(*this).sqrMagnitude(); }
+
+    T magnitude() const { return Vector2T<T>(*this).magnitude(); }
+
+    Vector2T<T> normalized() const { return Vector2T<T>(*this).normalized(); }
+};
+
 typedef Vector2T<float> Vector2;
 typedef Vector2T<int> Vector2Int;
+typedef Vector2RefT<float> Vector2Ref;
 
 #endif //INTROECS_VECTOR2_H
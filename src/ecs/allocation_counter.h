@@ -0,0 +1,50 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef ECS_ALLOCATION_COUNTER_H
+#define ECS_ALLOCATION_COUNTER_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace ecs {
+
+    // Allocations made by the containers of every world for their own bookkeeping
+    inline std::atomic<size_t> worldAllocations { 0 };
+
+    template <typename T>
+    struct CountingAllocator {
+        typedef T value_type;
+
+        CountingAllocator() = default;
+
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U>&) {}
+
+        T* allocate(size_t count) {
+            worldAllocations.fetch_add(1, std::memory_order_relaxed);
+            return std::allocator<T>().allocate(count);
+        }
+
+        void deallocate(T* pointer, size_t count) {
+            std::allocator<T>().deallocate(pointer, count);
+        }
+
+        template <typename U>
+        bool operator==(const CountingAllocator<U>&) const { return true; }
+
+        template <typename U>
+        bool operator!=(const CountingAllocator<U>&) const { return false; }
+    };
+
+    template <typename T>
+    using CountedVector = std::vector<T, CountingAllocator<T>>;
+
+    template <typename K, typename V>
+    using CountedMap = std::map<K, V, std::less<K>, CountingAllocator<std::pair<const K, V>>>;
+}
+
+#endif //ECS_ALLOCATION_COUNTER_H
@@ -5,8 +5,11 @@
 #ifndef ECS_FILTER_H
 #define ECS_FILTER_H
 
+#include <type_traits>
 #include <utility>
 #include <vector>
+#include "pools.h"
+#include "sparse_set.h"
 #include "types.h"
 
 namespace ecs {
@@ -15,40 +18,90 @@ namespace ecs {
     private:
         const IWorldEventListener & _listener;
 
-        std::vector<Type> _include;
-        std::vector<Type> _exclude;
+        Signature _include;
+        Signature _exclude;
 
-        std::set<Entity> _entities;
+        SparseSet _entities;
 
     public:
-        FilterImpl(const IWorldEventListener & listener, std::vector<Type> include, std::vector<Type> exclude)
+        FilterImpl(const IWorldEventListener & listener, const Signature & include, const Signature & exclude)
         : _listener(listener)
-        , _include(std::move(include))
-        , _exclude(std::move(exclude))
+        , _include(include)
+        , _exclude(exclude)
+        , _entities(listener.capacity())
         {
         }
 
-        std::set<Entity>& entities() override { return _entities; }
+        const Entities& entities() override { return _entities.entities(); }
 
         void update(const Entity& entity) override {
+            auto contains = _entities.contains(entity);
             if (check(entity)) {
-                _entities.insert(entity);
+                if (!contains) _entities.push(entity);
             } else {
-                _entities.erase(entity);
+                if (contains) _entities.remove(entity);
+            }
+        }
+
+        void erase(const Entities& entities) override {
+            for (const auto& entity : entities) {
+                if (_entities.contains(entity)) _entities.remove(entity);
             }
         }
 
     private:
         bool check(const Entity &entity) {
-            return std::all_of(
-                    _include.begin(),
-                    _include.end(),
-                    [this, &entity](const Type &type) { return _listener.hasComponent(entity, type); }
-            ) && std::all_of(
-                    _exclude.begin(),
-                    _exclude.end(),
-                    [this, &entity](const Type &type) { return !_listener.hasComponent(entity, type); }
-            );
+            if (!_listener.isEnabled(entity)) return false;
+
+            const auto &signature = _listener.signature(entity);
+            return (signature & _include) == _include && (signature & _exclude).none();
+        }
+    };
+
+    // The entities of a shared filter whose components of the added types were added, and of the
+    // changed types added or written, since the running system ran the last time. Not shared, every
+    // system sees the changes since its own last run. The world updates the wrapped filter, the
+    // entities are picked from it on every call.
+    class ChangeFilter : public Filter {
+    private:
+        const IWorldEventListener & _listener;
+        std::shared_ptr<Filter> _filter;
+
+        Signature _added;
+        Signature _changed;
+
+        Entities _entities;
+
+    public:
+        ChangeFilter(const IWorldEventListener & listener, std::shared_ptr<Filter> filter,
+                     const Signature & added, const Signature & changed)
+        : _listener(listener)
+        , _filter(std::move(filter))
+        , _added(added)
+        , _changed(changed)
+        {
+            _entities.reserve(listener.capacity());
+        }
+
+        const Entities& entities() override {
+            _entities.clear();
+            for (const auto& entity : _filter->entities()) {
+                if (check(entity)) _entities.push_back(entity);
+            }
+            return _entities;
+        }
+
+        void update(const Entity&) override {}
+
+        void erase(const Entities&) override {}
+
+    private:
+        bool check(const Entity &entity) {
+            for (uint32_t id = 0; id < MAX_COMPONENT_TYPES; ++id) {
+                if (_added.test(id) && !_listener.pool(id)->added(entity)) return false;
+                if (_changed.test(id) && !_listener.pool(id)->changed(entity)) return false;
+            }
+            return true;
         }
     };
 
@@ -59,6 +112,8 @@ namespace ecs {
 
         std::vector<Type> _include;
         std::vector<Type> _exclude;
+        std::vector<Type> _added;
+        std::vector<Type> _changed;
 
     public:
         explicit Mask(IWorldEventListener & listener)
@@ -80,14 +135,40 @@ namespace ecs {
             return *this;
         }
 
+        // includes T and keeps the entities that got it since the system ran the last time
+        template <typename T>
+        Mask& added()
+        {
+            static_assert(!std::is_empty_v<T>, "tags keep no ticks");
+            _added.push_back(createType<T>());
+            return include<T>();
+        }
+
+        // includes T and keeps the entities that got or wrote it since the system ran the last time
+        template <typename T>
+        Mask& changed()
+        {
+            static_assert(!std::is_empty_v<T>, "tags keep no ticks");
+            _changed.push_back(createType<T>());
+            return include<T>();
+        }
+
+        // Masks with the same include and exclude sets share one filter, whatever the order
+        // of the types and however many times they are listed. With added or changed types
+        // the mask gets its own ChangeFilter over the shared one.
         std::shared_ptr<Filter> build() {
-            auto filter = std::make_shared<FilterImpl>(
-                    _listener,
-                    std::move(_include),
-                    std::move(_exclude)
-            );
-            _listener.onFilterCreated(filter);
-            return filter;
+            Signature include;
+            Signature exclude;
+            Signature added;
+            Signature changed;
+            for (const auto &type : _include) include.set(_listener.typeId(type));
+            for (const auto &type : _exclude) exclude.set(_listener.typeId(type));
+            for (const auto &type : _added) added.set(_listener.typeId(type));
+            for (const auto &type : _changed) changed.set(_listener.typeId(type));
+
+            auto filter = _listener.filter(include, exclude);
+            if (added.none() && changed.none()) return filter;
+            return std::make_shared<ChangeFilter>(_listener, std::move(filter), added, changed);
         }
     };
 }
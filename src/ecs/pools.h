@@ -5,8 +5,12 @@
 #ifndef ECS_POOLS_H
 #define ECS_POOLS_H
 
+#include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
+#include "soa.h"
+#include "sparse_set.h"
 #include "types.h"
 
 namespace ecs {
@@ -25,57 +29,333 @@ namespace ecs {
         virtual void del(const Entity& entity) {
             throw std::runtime_error("Should be override in derived class");
         }
+
+        // drops the components of deleted entities, the world already forgot about them
+        virtual void erase(const Entities&) {
+            throw std::runtime_error("Should be override in derived class");
+        }
+
+        // for the filters of changes, see Mask::added and Mask::changed
+        [[nodiscard]] virtual bool added(const Entity&) const {
+            throw std::runtime_error("Should be override in derived class");
+        }
+
+        [[nodiscard]] virtual bool changed(const Entity&) const {
+            throw std::runtime_error("Should be override in derived class");
+        }
     };
 
+    // How a pool keeps its components: a dense array of values, float columns for the types with
+    // a SoaLayout, or for empty types nothing but their bit in the signature of the entity
+    enum class Storage { Dense, Columns, Signature };
+
+    template <typename T>
+    constexpr Storage storageOf() {
+        if constexpr (std::is_empty_v<T>) return Storage::Signature;
+        else if constexpr (SoaLayout<T>::ENABLED) return Storage::Columns;
+        else return Storage::Dense;
+    }
+
+    template <typename T, Storage STORAGE = storageOf<T>()>
+    class Pool;
+
+    // Every component remembers the world tick it was added at and the tick it was last written at
+    // through write or markChanged, get does not count as a change. The values are packed in one
+    // array reserved for the capacity of the world, a reference from get is valid until the next
+    // component of the type is added or the world updates.
     template <typename T>
-    class Pool : public __Pool__ {
+    class Pool<T, Storage::Dense> : public __Pool__ {
+        static_assert(std::is_move_assignable_v<T>, "a removed component is overwritten by the last one");
+
     private:
+        struct Slot {
+            T value;
+            Tick added;
+            Tick changed;
+        };
+
         IWorldEventListener& _listener;
-        std::map<Entity, T> _components;
+        uint32_t _id;
+        SparseSet _entities;            // removed components stay until the update, see has
+        CountedVector<Slot> _slots;     // by position in _entities
 
     public:
         explicit Pool(IWorldEventListener& listener)
         : __Pool__(createType<T>())
         , _listener(listener)
+        , _id(listener.typeId(type()))
+        , _entities(listener.capacity())
         {
+            _slots.reserve(listener.capacity());
         }
 
+        // A component removed by del stays in the pool until the update, for the remove observers
+        // to read it, but the entity does not have it anymore
         [[nodiscard]] bool has(const Entity& entity) const override {
-            return _components.find(entity) != _components.end();
+            return _entities.contains(entity) && _listener.signature(entity).test(_id);
         }
 
         void add(const Entity& entity) { add(entity, T()); }
 
         void add(const Entity& entity, const T& component) {
             if (has(entity)) {
-                throw std::runtime_error(&"The given component already exist on Entity" [entity]);
+                throw std::runtime_error("The given component already exist on Entity " + std::to_string(entity));
             }
-            _components.try_emplace(entity, component);
+            insert(entity, component);
             _listener.onEntityChanged(entity, type(), IWorldEventListener::ComponentAdded);
         }
 
+        // Adds or replaces without telling the world, for batches that update the world once for
+        // all their entities. A replaced component counts as added again.
+        void insert(const Entity& entity, const T& component) {
+            if (!_entities.contains(entity)) {
+                push(entity, component);
+                return;
+            }
+
+            auto tick = _listener.tick();
+            _slots[_entities.position(entity)] = Slot { component, tick, tick };
+        }
+
         T& get(const Entity& entity) {
+            return _slots[position(entity)].value;
+        }
+
+        const T& get(const Entity& entity) const {
+            return _slots[position(entity)].value;
+        }
+
+        // get that counts as a change
+        T& write(const Entity& entity) {
+            auto &slot = _slots[position(entity)];
+            slot.changed = _listener.tick();
+            return slot.value;
+        }
+
+        // for changes made through a reference from get
+        void markChanged(const Entity& entity) {
+            _slots[position(entity)].changed = _listener.tick();
+        }
+
+        // added since the running system ran the last time
+        [[nodiscard]] bool added(const Entity& entity) const override {
+            return _slots[position(entity)].added > _listener.lastRunTick();
+        }
+
+        // added or written since the running system ran the last time
+        [[nodiscard]] bool changed(const Entity& entity) const override {
+            return _slots[position(entity)].changed > _listener.lastRunTick();
+        }
+
+        // the world erases the component at the update
+        void del(const Entity& entity) override {
             if (!has(entity)) {
-                throw std::runtime_error(&"No component for Entity" [entity]);
+                throw std::runtime_error("No component for Entity " + std::to_string(entity));
+            }
+            _listener.onEntityChanged(entity, type(), IWorldEventListener::ComponentDeleted);
+        }
+
+        void erase(const Entities& entities) override {
+            for (const auto& entity : entities) {
+                if (_entities.contains(entity)) removeAt(_slots, _entities.remove(entity));
             }
+        }
 
-            return _components.find(entity)->second;
+    private:
+        void push(const Entity& entity, const T& component) {
+            auto tick = _listener.tick();
+            _entities.push(entity);
+            _slots.push_back(Slot { component, tick, tick });
         }
 
-        const T& get(const Entity& entity) const {
+        const Entity& checked(const Entity& entity) const {
+            if (!_entities.contains(entity)) {
+                throw std::runtime_error("No component for Entity " + std::to_string(entity));
+            }
+            return entity;
+        }
+
+        [[nodiscard]] uint32_t position(const Entity& entity) const {
+            return _entities.position(checked(entity));
+        }
+    };
+
+    // Structure of arrays storage for the components with a SoaLayout. The mutable get and write
+    // return a proxy with references into the columns, the const get a copy. The proxy is valid
+    // until the next component of the type is added or the world updates. Kernels take the columns
+    // and the dense index of every entity they work on.
+    template <typename T>
+    class Pool<T, Storage::Columns> : public __Pool__ {
+    public:
+        typedef SoaLayout<T> Layout;
+        typedef typename Layout::Ref Ref;
+
+    private:
+        IWorldEventListener& _listener;
+        uint32_t _id;
+        SparseSet _entities;                // the columns are in the same order
+        Columns<Layout::COLUMNS> _columns;
+        CountedVector<Tick> _added;
+        CountedVector<Tick> _changed;
+
+    public:
+        explicit Pool(IWorldEventListener& listener)
+        : __Pool__(createType<T>())
+        , _listener(listener)
+        , _id(listener.typeId(type()))
+        , _entities(listener.capacity())
+        {
+            for (auto& column : _columns) column.reserve(listener.capacity());
+            _added.reserve(listener.capacity());
+            _changed.reserve(listener.capacity());
+        }
+
+        // A component removed by del stays in the pool until the update, for the remove observers
+        // to read it, but the entity does not have it anymore
+        [[nodiscard]] bool has(const Entity& entity) const override {
+            return _entities.contains(entity) && _listener.signature(entity).test(_id);
+        }
+
+        void add(const Entity& entity) { add(entity, T()); }
+
+        void add(const Entity& entity, const T& component) {
+            if (has(entity)) {
+                throw std::runtime_error("The given component already exist on Entity " + std::to_string(entity));
+            }
+            insert(entity, component);
+            _listener.onEntityChanged(entity, type(), IWorldEventListener::ComponentAdded);
+        }
+
+        void insert(const Entity& entity, const T& component) {
+            if (!_entities.contains(entity)) {
+                push(entity, component);
+                return;
+            }
+
+            auto i = _entities.position(entity);
+            Layout::store(component, _columns, i);
+            _added[i] = _changed[i] = _listener.tick();
+        }
+
+        Ref get(const Entity& entity) {
+            return Layout::ref(_columns, index(entity));
+        }
+
+        T get(const Entity& entity) const {
+            return Layout::load(_columns, index(entity));
+        }
+
+        Ref write(const Entity& entity) {
+            auto i = index(entity);
+            _changed[i] = _listener.tick();
+            return Layout::ref(_columns, i);
+        }
+
+        void markChanged(const Entity& entity) {
+            _changed[index(entity)] = _listener.tick();
+        }
+
+        [[nodiscard]] bool added(const Entity& entity) const override {
+            return _added[index(entity)] > _listener.lastRunTick();
+        }
+
+        [[nodiscard]] bool changed(const Entity& entity) const override {
+            return _changed[index(entity)] > _listener.lastRunTick();
+        }
+
+        void del(const Entity& entity) override {
             if (!has(entity)) {
-                throw std::runtime_error(&"No component for Entity" [entity]);
+                throw std::runtime_error("No component for Entity " + std::to_string(entity));
+            }
+            _listener.onEntityChanged(entity, type(), IWorldEventListener::ComponentDeleted);
+        }
+
+        void erase(const Entities& entities) override {
+            for (const auto& entity : entities) {
+                if (_entities.contains(entity)) remove(_entities.remove(entity));
+            }
+        }
+
+        // position of the entity's fields in the columns
+        [[nodiscard]] uint32_t index(const Entity& entity) const {
+            return _entities.position(checked(entity));
+        }
+
+        float* column(size_t column) { return _columns[column].data(); }
+
+        [[nodiscard]] const float* column(size_t column) const { return _columns[column].data(); }
+
+        // for kernels writing the columns directly
+        void markChanged(const std::vector<uint32_t>& indices) {
+            auto tick = _listener.tick();
+            for (auto index : indices) _changed[index] = tick;
+        }
+
+    private:
+        void push(const Entity& entity, const T& component) {
+            auto i = _entities.push(entity);
+            for (auto& column : _columns) column.emplace_back();
+            Layout::store(component, _columns, i);
+
+            auto tick = _listener.tick();
+            _added.push_back(tick);
+            _changed.push_back(tick);
+        }
+
+        const Entity& checked(const Entity& entity) const {
+            if (!_entities.contains(entity)) {
+                throw std::runtime_error("No component for Entity " + std::to_string(entity));
+            }
+            return entity;
+        }
+
+        // the last entity moved into the hole, the columns follow
+        void remove(uint32_t i) {
+            for (auto& column : _columns) removeAt(column, i);
+            removeAt(_added, i);
+            removeAt(_changed, i);
+        }
+    };
+
+    // Empty components, the tags, exist only as their bit in the signature of the entity. There is
+    // nothing to get and no change to track, has is a bit test.
+    template <typename T>
+    class Pool<T, Storage::Signature> : public __Pool__ {
+    private:
+        IWorldEventListener& _listener;
+        uint32_t _id;
+
+    public:
+        explicit Pool(IWorldEventListener& listener)
+        : __Pool__(createType<T>())
+        , _listener(listener)
+        , _id(listener.typeId(type()))
+        {
+        }
+
+        [[nodiscard]] bool has(const Entity& entity) const override {
+            return _listener.signature(entity).test(_id);
+        }
+
+        void add(const Entity& entity, const T& = T()) {
+            if (has(entity)) {
+                throw std::runtime_error("The given component already exist on Entity " + std::to_string(entity));
             }
-            return _components.find(entity)->second;
+            _listener.onEntityChanged(entity, type(), IWorldEventListener::ComponentAdded);
         }
 
+        // instances of a prefab get the bit with the rest of its signature
+        void insert(const Entity&, const T&) {}
+
         void del(const Entity& entity) override {
             if (!has(entity)) {
-                throw std::runtime_error(&"No component for Entity" [entity]);
+                throw std::runtime_error("No component for Entity " + std::to_string(entity));
             }
-            _components.erase(entity);
             _listener.onEntityChanged(entity, type(), IWorldEventListener::ComponentDeleted);
         }
+
+        // the world clears the bits of deleted entities
+        void erase(const Entities&) override {}
     };
 }
 
@@ -0,0 +1,83 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef ECS_PREFAB_H
+#define ECS_PREFAB_H
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "types.h"
+#include "pools.h"
+
+namespace ecs {
+
+    // Named set of components with their default values, instantiated by World::instantiate
+    class Prefab {
+    public:
+        struct Component {
+            Type type;
+            // makes the pool for a world that has none of this type yet
+            std::function<std::shared_ptr<__Pool__>(IWorldEventListener&)> createPool;
+            // adds the default value to every entity or sets it back, without telling the world
+            std::function<void(__Pool__&, const Entities&)> insert;
+        };
+
+    private:
+        std::string _name;
+        std::vector<Component> _components;
+        std::set<Type> _types;
+        bool _recycled = false;
+
+    public:
+        Prefab() = default;
+
+        explicit Prefab(std::string name)
+        : _name(std::move(name))
+        {
+        }
+
+        template <typename T>
+        Prefab& with(const T& component) {
+            auto type = createType<T>();
+            if (!_types.insert(type).second) {
+                throw std::runtime_error("Prefab " + _name + " already has the component " + type.name());
+            }
+
+            _components.push_back({
+                    type,
+                    [](IWorldEventListener& listener) { return std::make_shared<Pool<T>>(listener); },
+                    [component](__Pool__& pool, const Entities& entities) {
+                        auto& typedPool = static_cast<Pool<T>&>(pool);
+                        for (const auto& entity : entities) typedPool.insert(entity, component);
+                    }
+            });
+            return *this;
+        }
+
+        // Deleted instances are disabled and kept with their components, instantiate takes them
+        // back before it creates new entities. For kinds that come and go all the time.
+        Prefab& recycled(bool recycled = true) {
+            _recycled = recycled;
+            return *this;
+        }
+
+        [[nodiscard]] bool isRecycled() const { return _recycled; }
+
+        template <typename T>
+        Prefab& with() { return with(T()); }
+
+        [[nodiscard]] const std::string& name() const { return _name; }
+
+        [[nodiscard]] const std::vector<Component>& components() const { return _components; }
+
+        // the component types of every instance
+        [[nodiscard]] const std::set<Type>& types() const { return _types; }
+    };
+}
+
+#endif //ECS_PREFAB_H
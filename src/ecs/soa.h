@@ -0,0 +1,30 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef ECS_SOA_H
+#define ECS_SOA_H
+
+#include <array>
+#include <cstddef>
+
+#include "allocation_counter.h"
+
+namespace ecs {
+
+    // one float array per field of a component
+    template <size_t N>
+    using Columns = std::array<CountedVector<float>, N>;
+
+    // Components opt into structure of arrays storage by specialising the trait with
+    //   ENABLED = true
+    //   COLUMNS - number of float columns, enumerators naming the columns before it
+    //   Ref - proxy with references into the columns, what the mutable Pool::get and write return
+    //   store(component, columns, index), load(columns, index), ref(columns, index)
+    template <typename T>
+    struct SoaLayout {
+        static constexpr bool ENABLED = false;
+    };
+}
+
+#endif //ECS_SOA_H
@@ -0,0 +1,73 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef ECS_SPARSE_SET_H
+#define ECS_SPARSE_SET_H
+
+#include <utility>
+
+#include "allocation_counter.h"
+#include "types.h"
+
+namespace ecs {
+
+    // Dense list of entities with the position of every entity by its index, for constant time
+    // lookup, insertion and removal. Containers kept next to it move their items the same way.
+    class SparseSet {
+    private:
+        Entities _dense;
+        CountedVector<uint32_t> _sparse;    // position + 1 by entity index, 0 - none
+
+    public:
+        explicit SparseSet(size_t capacity) {
+            _dense.reserve(capacity);
+            _sparse.reserve(capacity);
+        }
+
+        [[nodiscard]] bool contains(const Entity &entity) const {
+            auto index = entityIndex(entity);
+            return index < _sparse.size() && _sparse[index] != 0 && _dense[_sparse[index] - 1] == entity;
+        }
+
+        // of a contained entity
+        [[nodiscard]] uint32_t position(const Entity &entity) const { return _sparse[entityIndex(entity)] - 1; }
+
+        [[nodiscard]] const Entities &entities() const { return _dense; }
+
+        [[nodiscard]] size_t size() const { return _dense.size(); }
+
+        // the entity goes last, returns its position
+        uint32_t push(const Entity &entity) {
+            auto index = entityIndex(entity);
+            if (index >= _sparse.size()) _sparse.resize(index + 1, 0);
+
+            auto position = uint32_t(_dense.size());
+            _dense.push_back(entity);
+            _sparse[index] = position + 1;
+            return position;
+        }
+
+        // The last entity takes the place of the removed one, returns that place. Items kept
+        // next to the set do the same: items[place] = items.back(), items.pop_back().
+        uint32_t remove(const Entity &entity) {
+            auto position = this->position(entity);
+            auto last = _dense.back();
+            _dense[position] = last;
+            _sparse[entityIndex(last)] = position + 1;
+
+            _dense.pop_back();
+            _sparse[entityIndex(entity)] = 0;
+            return position;
+        }
+    };
+
+    // moves the last item into the place of a removed one, see SparseSet::remove
+    template <typename V>
+    void removeAt(V &items, uint32_t position) {
+        if (position + 1 != items.size()) items[position] = std::move(items.back());
+        items.pop_back();
+    }
+}
+
+#endif //ECS_SPARSE_SET_H
@@ -134,6 +134,9 @@ namespace ecs {
         std::vector<std::shared_ptr<IDisposeSystem>> _disposeSystems;
         std::vector<std::shared_ptr<IPostDisposeSystem>> _postDisposeSystems;
 
+        // tick every system ran at the last time, changes are reported to it relative to this
+        std::map<const ISystem*, Tick> _lastRunTicks;
+
         Systems(
                 std::map<std::string, bool> systemsWithStatus,
                 std::vector<std::shared_ptr<IPreInitSystem>> preInitSystems,
@@ -159,19 +162,27 @@ namespace ecs {
             return it != _systemsWithStatus.end() && it->second;
         }
 
+        template <typename S, typename F>
+        void execute(World& world, const std::shared_ptr<S>& system, F&& f) {
+            auto& lastRunTick = _lastRunTicks[system.get()];
+            lastRunTick = world.beginSystem(lastRunTick);
+            f(*system);
+            world.endSystem();
+        }
+
     public:
         std::map<std::string, bool>& systemsWithStatus() { return _systemsWithStatus; }
 
-        void init(World& world) const {
+        void init(World& world) {
             for (const auto& preInitSystem : _preInitSystems) {
                 if (preInitSystem && isSystemEnabled(preInitSystem->name()))
-                    preInitSystem->preInit(world);
+                    execute(world, preInitSystem, [&world](auto& system) { system.preInit(world); });
             }
             world.update();
 
             for (const auto& initSystem : _initSystems) {
                 if (initSystem && isSystemEnabled(initSystem->name()))
-                    initSystem->init(world);
+                    execute(world, initSystem, [&world](auto& system) { system.init(world); });
             }
             world.update();
         }
@@ -179,7 +190,7 @@ namespace ecs {
         void event(World& world, const sf::Event& event) {
             for (const auto& eventSystem : _eventSystems) {
                 if (eventSystem && isSystemEnabled(eventSystem->name()))
-                    eventSystem->event(world, event);
+                    execute(world, eventSystem, [&world, &event](auto& system) { system.event(world, event); });
             }
             world.update();
         }
@@ -187,7 +198,7 @@ namespace ecs {
         void run(World& world, const sf::Time& dt) {
             for (const auto& runSystems : _runSystems) {
                 if (runSystems && isSystemEnabled(runSystems->name()))
-                    runSystems->run(world, dt);
+                    execute(world, runSystems, [&world, &dt](auto& system) { system.run(world, dt); });
             }
             world.update();
         }
@@ -195,7 +206,7 @@ namespace ecs {
         void render(World& world) {
             for (const auto& renderSystem : _renderSystems) {
                 if (renderSystem && isSystemEnabled(renderSystem->name()))
-                    renderSystem->render(world);
+                    execute(world, renderSystem, [&world](auto& system) { system.render(world); });
             }
             world.update();
         }
@@ -203,13 +214,13 @@ namespace ecs {
         void dispose(World& world) {
             for (const auto& disposeSystem : _disposeSystems) {
                 if (disposeSystem && isSystemEnabled(disposeSystem->name()))
-                    disposeSystem->dispose(world);
+                    execute(world, disposeSystem, [&world](auto& system) { system.dispose(world); });
             }
             world.update();
 
             for (const auto& postDisposeSystem : _postDisposeSystems) {
                 if (postDisposeSystem && isSystemEnabled(postDisposeSystem->name()))
-                    postDisposeSystem->postDispose(world);
+                    execute(world, postDisposeSystem, [&world](auto& system) { system.postDispose(world); });
             }
             world.update();
         }
@@ -1,14 +1,35 @@
 #ifndef ECS_TYPE_H
 #define ECS_TYPE_H
 
+#include <bitset>
+#include <cstdint>
 #include <memory>
 #include <set>
 #include <map>
 
+#include "allocation_counter.h"
+
 namespace ecs {
 
+    // Index of the entity's record in the world and the generation of the record, the record is
+    // reused after the entity is deleted and a kept id does not reach the next entity using it
     typedef u_int64_t Entity;
 
+    typedef CountedVector<Entity> Entities;
+
+    inline Entity createEntity(uint32_t index, uint32_t generation) { return Entity(generation) << 32 | index; }
+
+    inline uint32_t entityIndex(const Entity &entity) { return uint32_t(entity); }
+
+    inline uint32_t entityGeneration(const Entity &entity) { return uint32_t(entity >> 32); }
+
+    // One bit per component type the entity has, by the id the world gave the type
+    static constexpr size_t MAX_COMPONENT_TYPES = 64;
+    typedef std::bitset<MAX_COMPONENT_TYPES> Signature;
+
+    // Advances after every system run, 0 is never
+    typedef u_int64_t Tick;
+
     class Type {
     private:
         const char *_name;
@@ -43,11 +64,17 @@ namespace ecs {
         return {typeInfo.name(), typeInfo.hash_code(), sizeof(T)};
     }
 
+    class __Pool__;
+
     class Filter {
     public:
-        virtual std::set<Entity> &entities() = 0;
+        // in no particular order
+        virtual const Entities &entities() = 0;
 
         virtual void update(const Entity &entity) = 0;
+
+        // drops deleted entities without checking them
+        virtual void erase(const Entities &entities) = 0;
     };
 
     class IWorldEventListener {
@@ -60,9 +87,31 @@ namespace ecs {
         virtual void onEntityCreated (const Entity& entity) = 0;
         virtual void onEntityChanged (const Entity& entity, const Type& type, EntityAction action) = 0;
         virtual void onEntityDeleted (const Entity& entity) = 0;
-        virtual void onFilterCreated (std::shared_ptr<Filter> filter) = 0;
+
+        // the filter of the entities with every include type and no exclude type, made on the first call
+        [[nodiscard]] virtual std::shared_ptr<Filter> filter(const Signature &include, const Signature &exclude) = 0;
 
         [[nodiscard]] virtual bool hasComponent(const Entity &entity, const Type &type) const = 0;
+
+        // small id of the type, the bit of the type in signatures
+        [[nodiscard]] virtual uint32_t typeId(const Type &type) = 0;
+
+        // the pool of the type by its id, null before the first pool of the type
+        [[nodiscard]] virtual const __Pool__* pool(uint32_t id) const = 0;
+
+        [[nodiscard]] virtual const Signature &signature(const Entity &entity) const = 0;
+
+        // disabled entities keep their components but are in no filter
+        [[nodiscard]] virtual bool isEnabled(const Entity &entity) const = 0;
+
+        // entities the world expects alive at once, its containers reserve for as many
+        [[nodiscard]] virtual size_t capacity() const = 0;
+
+        // tick of the running system
+        [[nodiscard]] virtual Tick tick() const = 0;
+
+        // tick the running system ran at the last time
+        [[nodiscard]] virtual Tick lastRunTick() const = 0;
     };
 }
 
@@ -1,117 +1,473 @@
 #ifndef ECS_WORLD_H
 #define ECS_WORLD_H
 
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <memory>
 #include <set>
 #include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
 
+#include "allocation_counter.h"
 #include "types.h"
 #include "filter.h"
 #include "pools.h"
+#include "prefab.h"
 
 namespace ecs {
 
     class World {
     private:
         struct WorldImpl : public IWorldEventListener {
-            Entity _lastEntity = 0;
-            std::set<Entity> _entities;
-            std::set<Entity> _entitiesToDelete;
-            std::set<Entity> _entitiesToUpdate;
-            std::map<Entity, std::set<Type>> _entityToComponentsTypeSet;
+            // Everything the world knows about one entity, by the index in its id
+            struct Record {
+                Signature signature;
+                const Prefab* recycledPrefab = nullptr;
+                uint32_t generation = 1;
+                uint32_t position = 0;      // in _entities
+                bool enabled = true;
+                bool parked = false;        // instance of a recycled prefab waiting to be reused
+                bool dirty = false;         // waits in _entitiesToUpdate
+                bool deleting = false;      // waits in _entitiesToDelete
+            };
+
+            typedef std::function<void(const Entities&)> Observer;
+
+            struct PrefabInstances {
+                Signature signature;
+                Entities parked;
+            };
+
+            // every container grows to the high water mark of the game and stays there,
+            // a steady frame allocates nothing
+            size_t _capacity;
+            Tick _tick = 1;
+            Tick _lastRunTick = 0;
+
+            CountedVector<Record> _records;
+            CountedVector<uint32_t> _freeIndices;
+            Entities _entities;
+            Entities _entitiesToDelete;
+            Entities _entitiesToUpdate;
+
+            uint32_t _typeCount = 0;
+            CountedMap<Type, uint32_t> _typeIds;
+            std::array<std::shared_ptr<__Pool__>, MAX_COMPONENT_TYPES> _pools;
+            CountedVector<std::shared_ptr<Filter>> _filters;
+            // by the include and exclude signatures, every call site with the same sets shares the filter
+            static_assert(MAX_COMPONENT_TYPES <= 64, "the key packs each signature into 64 bits");
+            CountedMap<std::pair<uint64_t, uint64_t>, std::shared_ptr<Filter>> _filtersBySignature;
+
+            Entities _batch;
+            Entities _recycled;
+            CountedMap<const Prefab*, PrefabInstances> _prefabInstances;
+            Entities _deleted;
+            // components removed since the last update, the pools drop them at the update
+            std::array<Entities, MAX_COMPONENT_TYPES> _removed;
+
+            // components added since the last update, kept for the observed types only
+            Signature _addObserved;
+            Signature _removeObserved;
+            std::array<CountedVector<Observer>, MAX_COMPONENT_TYPES> _onAdd;
+            std::array<CountedVector<Observer>, MAX_COMPONENT_TYPES> _onRemove;
+            std::array<Entities, MAX_COMPONENT_TYPES> _added;
+            Entities _notified;
 
-            std::map<Type, std::shared_ptr<__Pool__>> _componentTypeToPool;
-            std::vector<std::shared_ptr<Filter>> _filters;
+            // one value per type for the whole world, not attached to any entity
+            CountedMap<Type, std::shared_ptr<void>> _resources;
 
-            WorldImpl() = default;
+            explicit WorldImpl(size_t capacity)
+            : _capacity(capacity)
+            {
+                _records.reserve(capacity);
+                _freeIndices.reserve(capacity);
+                _entities.reserve(capacity);
+                _entitiesToDelete.reserve(capacity);
+                _entitiesToUpdate.reserve(capacity);
+                _batch.reserve(capacity);
+                _recycled.reserve(capacity);
+                _deleted.reserve(capacity);
+                _notified.reserve(capacity);
+            }
 
             void onEntityCreated (const Entity& entity) override {
-                _entitiesToUpdate.insert(entity);
+                markDirty(entity);
             };
 
             void onEntityChanged (const Entity& entity, const Type& type, EntityAction action) override {
-                if (action == ComponentAdded) _entityToComponentsTypeSet[entity].insert(type);
-                if (action == ComponentDeleted) _entityToComponentsTypeSet[entity].erase(type);
+                auto record = find(entity);
+                if (!record) return;
+
+                auto id = typeId(type);
+                record->signature.set(id, action == ComponentAdded);
+                markDirty(entity);
 
-                _entitiesToUpdate.insert(entity);
+                if (action == ComponentAdded && _addObserved.test(id)) _added[id].push_back(entity);
+                if (action == ComponentDeleted) _removed[id].push_back(entity);
             };
 
             void onEntityDeleted (const Entity& entity) override {
-                _entitiesToUpdate.insert(entity);
+                markDirty(entity);
             };
 
-            void onFilterCreated(std::shared_ptr<Filter> filter) override {
+            [[nodiscard]] std::shared_ptr<Filter> filter(const Signature &include, const Signature &exclude) override {
+                auto key = std::make_pair(uint64_t(include.to_ullong()), uint64_t(exclude.to_ullong()));
+                auto it = _filtersBySignature.find(key);
+                if (it != _filtersBySignature.end()) return it->second;
+
+                // a query made after its entities gets them now, not when they change next
+                auto filter = std::make_shared<FilterImpl>(*this, include, exclude);
+                for (auto entity: _entities) filter->update(entity);
+
                 _filters.push_back(filter);
+                _filtersBySignature.try_emplace(key, filter);
+                return filter;
             }
 
             [[nodiscard]] bool hasComponent(const Entity &entity, const Type &type) const override {
-                auto it = _entityToComponentsTypeSet.find(entity);
-                if (it != _entityToComponentsTypeSet.end()) {
-                    auto &components = it->second;
-                    return components.find(type) != components.end();
+                auto it = _typeIds.find(type);
+                return it != _typeIds.end() && signature(entity).test(it->second);
+            }
+
+            [[nodiscard]] uint32_t typeId(const Type &type) override {
+                auto it = _typeIds.find(type);
+                if (it != _typeIds.end()) return it->second;
+
+                if (_typeCount == MAX_COMPONENT_TYPES) {
+                    throw std::runtime_error(std::string("Too many component types for ") + type.name());
                 }
+                _removed[_typeCount].reserve(_capacity);
+                _typeIds.try_emplace(type, _typeCount);
+                return _typeCount++;
+            }
 
-                return false;
+            [[nodiscard]] const __Pool__* pool(uint32_t id) const override {
+                return _pools[id].get();
             }
 
-            Entity newEntity() {
-                auto entity = ++_lastEntity;
+            [[nodiscard]] const Signature &signature(const Entity &entity) const override {
+                static const Signature EMPTY;
 
-                _entities.insert(entity);
-                onEntityCreated(entity);
+                auto record = find(entity);
+                return record ? record->signature : EMPTY;
+            }
+
+            [[nodiscard]] bool isEnabled(const Entity &entity) const override {
+                auto record = find(entity);
+                return record && record->enabled;
+            }
+
+            void setEnabled(const Entity &entity, bool enabled) {
+                auto record = find(entity);
+                if (!record || record->parked) return;
+
+                record->enabled = enabled;
+                markDirty(entity);
+            }
+
+            [[nodiscard]] size_t capacity() const override { return _capacity; }
+
+            [[nodiscard]] Tick tick() const override { return _tick; }
 
+            [[nodiscard]] Tick lastRunTick() const override { return _lastRunTick; }
+
+            // null once the entity is deleted, parked instances of recycled prefabs still have theirs
+            [[nodiscard]] const Record* find(const Entity &entity) const {
+                auto index = entityIndex(entity);
+                if (index >= _records.size() || _records[index].generation != entityGeneration(entity)) return nullptr;
+                return &_records[index];
+            }
+
+            Record* find(const Entity &entity) {
+                return const_cast<Record*>(std::as_const(*this).find(entity));
+            }
+
+            Entity newEntity() {
+                auto entity = createRecord();
+                onEntityCreated(entity);
                 return entity;
             }
 
             void deleteEntity(const Entity &entity) {
-                _entitiesToDelete.insert(entity);
-                onEntityDeleted(entity);
+                auto record = find(entity);
+                if (!record || record->deleting || record->parked) return;
+
+                record->deleting = true;
+                _entitiesToDelete.push_back(entity);
             }
 
             Mask buildFilter() {
                 return Mask(*this);
             }
 
-            void update() {
-                // Delete entities and attached components
-                for (auto entity: _entitiesToDelete) {
-                    auto componentTypeSet = _entityToComponentsTypeSet[entity];
-                    for (const auto &type: componentTypeSet) {
-                        auto it = _componentTypeToPool.find(type);
-                        if (it != _componentTypeToPool.end()) {
-                            auto pool =  it->second;
-                            pool->del(entity);
-                        }
+            template<typename F>
+            void instantiate(const Prefab& prefab, size_t count, F&& init) {
+                _batch.clear();
+                _recycled.clear();
+
+                auto &instances = _prefabInstances[&prefab];
+                if (instances.signature.none()) {
+                    for (const auto &type: prefab.types()) instances.signature.set(typeId(type));
+                    if (prefab.isRecycled()) instances.parked.reserve(_capacity);
+                }
+
+                // parked instances first, they still have the components and the signature
+                while (!instances.parked.empty() && _recycled.size() < count) {
+                    auto entity = instances.parked.back();
+                    instances.parked.pop_back();
+
+                    auto &record = _records[entityIndex(entity)];
+                    record.enabled = true;
+                    record.parked = false;
+                    record.position = uint32_t(_entities.size());
+                    _entities.push_back(entity);
+                    markDirty(entity);
+                    _recycled.push_back(entity);
+                }
+
+                // every new instance has the same signature, the filters see them at the next update
+                for (size_t i = _recycled.size(); i < count; ++i) {
+                    auto entity = createRecord();
+                    auto &record = _records[entityIndex(entity)];
+                    record.signature = instances.signature;
+                    record.recycledPrefab = prefab.isRecycled() ? &prefab : nullptr;
+                    markDirty(entity);
+                    _batch.push_back(entity);
+                }
+
+                for (const auto& component : prefab.components()) {
+                    auto id = typeId(component.type);
+                    if (!_pools[id]) _pools[id] = component.createPool(*this);
+
+                    component.insert(*_pools[id], _recycled);
+                    component.insert(*_pools[id], _batch);
+
+                    if (_addObserved.test(id)) {
+                        _added[id].insert(_added[id].end(), _recycled.begin(), _recycled.end());
+                        _added[id].insert(_added[id].end(), _batch.begin(), _batch.end());
                     }
-                    _entityToComponentsTypeSet.erase(entity);
-                    _entities.erase(entity);
                 }
-                _entitiesToDelete.clear();
+
+                for (size_t i = 0; i < _recycled.size(); ++i) {
+                    init(_recycled[i], i);
+                }
+                for (size_t i = 0; i < _batch.size(); ++i) {
+                    init(_batch[i], _recycled.size() + i);
+                }
+            }
+
+            void update() {
+                if (!_entitiesToDelete.empty()) {
+                    deleteEntities();
+                } else {
+                    eraseRemoved();
+                }
 
                 // Update filters
                 for (auto entity: _entitiesToUpdate) {
+                    auto record = find(entity);
+                    if (!record || !record->dirty) continue;
+                    record->dirty = false;
+
                     for (auto & filter: _filters) {
                         filter->update(entity);
                     }
                 }
                 _entitiesToUpdate.clear();
+
+                notifyAdded();
+            }
+
+            void observe(const Type &type, Observer observer, Signature &observed,
+                         std::array<CountedVector<Observer>, MAX_COMPONENT_TYPES> &observers,
+                         std::array<Entities, MAX_COMPONENT_TYPES> &events) {
+                auto id = typeId(type);
+                observed.set(id);
+                observers[id].push_back(std::move(observer));
+                events[id].reserve(_capacity);
+            }
+
+            // Hands the added components of every observed type to its observers, the ones that are
+            // gone again left out. Events raised by the observers wait for the next update.
+            void notifyAdded() {
+                for (uint32_t id = 0; _addObserved.any() && id < _typeCount; ++id) {
+                    if (!_addObserved.test(id) || _added[id].empty()) continue;
+
+                    _notified.swap(_added[id]);
+                    _notified.erase(std::remove_if(_notified.begin(), _notified.end(), [this, id](const Entity &entity) {
+                        auto record = find(entity);
+                        return !record || !record->signature.test(id);
+                    }), _notified.end());
+                    dispatch(_onAdd[id]);
+                }
+            }
+
+            // Hands the removed components of every type to its remove observers while the pool
+            // still has them, then the pool drops them. The ones added back since stay, unless their
+            // entity is deleted. Events raised by the observers wait for the next update.
+            void eraseRemoved() {
+                for (uint32_t id = 0; id < _typeCount; ++id) {
+                    if (_removed[id].empty()) continue;
+
+                    _notified.swap(_removed[id]);
+                    _notified.erase(std::remove_if(_notified.begin(), _notified.end(), [this, id](const Entity &entity) {
+                        auto record = find(entity);
+                        return record && !record->deleting && record->signature.test(id);
+                    }), _notified.end());
+
+                    if (_removeObserved.test(id) && !_notified.empty()) {
+                        for (const auto &observer: _onRemove[id]) observer(_notified);
+                    }
+                    if (_pools[id]) _pools[id]->erase(_notified);
+                    _notified.clear();
+                }
+            }
+
+            void dispatch(const CountedVector<Observer> &observers) {
+                if (!_notified.empty()) {
+                    for (const auto &observer: observers) observer(_notified);
+                }
+                _notified.clear();
+            }
+
+            // Delete entities and attached components. The entities are grouped by component type
+            // so every pool and every filter drops all of them at once, without the notifications
+            // of removing the components one by one. Remove observers run before the pools drop
+            // the components, the deleted entities still have them.
+            void deleteEntities() {
+                _deleted.assign(_entitiesToDelete.begin(), _entitiesToDelete.end());
+                _entitiesToDelete.clear();
+
+                for (auto entity: _deleted) {
+                    auto &record = _records[entityIndex(entity)];
+                    record.dirty = false;
+                    removeFromEntities(record);
+
+                    if (record.recycledPrefab) {
+                        park(entity, record);
+                    } else {
+                        eraseComponents(entity, record.signature);
+                    }
+                }
+
+                eraseRemoved();
+
+                for (auto entity: _deleted) {
+                    auto index = entityIndex(entity);
+                    auto &record = _records[index];
+                    record.deleting = false;
+                    if (record.parked) continue;
+
+                    record.signature.reset();
+                    record.enabled = true;
+                    ++record.generation;
+                    _freeIndices.push_back(index);
+                }
+
+                for (auto &filter: _filters) {
+                    filter->erase(_deleted);
+                }
+            }
+
+            // Disables an instance of a recycled prefab instead of deleting it, only the components
+            // added after it was instantiated go away
+            void park(const Entity &entity, Record &record) {
+                auto &instances = _prefabInstances[record.recycledPrefab];
+
+                eraseComponents(entity, record.signature & ~instances.signature);
+                record.signature = instances.signature;
+                record.enabled = false;
+                record.parked = true;
+                instances.parked.push_back(entity);
+            }
+
+            void eraseComponents(const Entity &entity, const Signature &signature) {
+                for (uint32_t id = 0; id < _typeCount; ++id) {
+                    if (signature.test(id)) _removed[id].push_back(entity);
+                }
+            }
+
+            Entity createRecord() {
+                uint32_t index;
+                if (!_freeIndices.empty()) {
+                    index = _freeIndices.back();
+                    _freeIndices.pop_back();
+                } else {
+                    index = uint32_t(_records.size());
+                    _records.emplace_back();
+                }
+
+                auto &record = _records[index];
+                auto entity = createEntity(index, record.generation);
+                record.position = uint32_t(_entities.size());
+                record.recycledPrefab = nullptr;
+                _entities.push_back(entity);
+                return entity;
+            }
+
+            void removeFromEntities(const Record &record) {
+                auto last = _entities.back();
+                _entities[record.position] = last;
+                _records[entityIndex(last)].position = record.position;
+                _entities.pop_back();
+            }
+
+            void markDirty(const Entity &entity) {
+                auto record = find(entity);
+                if (!record || record->dirty) return;
+
+                record->dirty = true;
+                _entitiesToUpdate.push_back(entity);
+            }
+
+            template<typename T, typename... Args>
+            std::shared_ptr<T> addResource(Args&&... args) {
+                auto type = createType<T>();
+                if (_resources.find(type) != _resources.end()) {
+                    throw std::runtime_error(std::string("The world already has the resource ") + type.name());
+                }
+
+                auto resource = std::make_shared<T>(std::forward<Args>(args)...);
+                _resources.try_emplace(type, resource);
+                return resource;
             }
 
             template<typename T>
-            std::shared_ptr<Pool<T>> pool() {
-                const auto & type = createType<T>();
-                auto it = _componentTypeToPool.find(type);
-                if (it == _componentTypeToPool.end()) {
-                    auto pool = std::make_shared<Pool<T>>(*this);
-                    _componentTypeToPool.try_emplace(type, std::dynamic_pointer_cast<__Pool__>(pool));
+            std::shared_ptr<T> resource() {
+                auto it = _resources.find(createType<T>());
+                if (it != _resources.end()) return std::static_pointer_cast<T>(it->second);
+
+                if constexpr (std::is_default_constructible_v<T>) {
+                    return addResource<T>();
+                } else {
+                    throw std::runtime_error(std::string("No resource ") + createType<T>().name());
                 }
-                return std::dynamic_pointer_cast<Pool<T>>(_componentTypeToPool[type]);
+            }
+
+            template<typename T>
+            std::shared_ptr<Pool<T>> pool() {
+                auto id = typeId(createType<T>());
+                if (!_pools[id]) _pools[id] = std::make_shared<Pool<T>>(*this);
+                return std::static_pointer_cast<Pool<T>>(_pools[id]);
             }
         };
 
         WorldImpl _impl;
 
     public:
+        // capacity - entities expected alive at once, the bookkeeping is reserved for them
+        explicit World(size_t capacity = 256)
+        : _impl(capacity)
+        {
+        }
+
+        World(const World&) = delete;
+        World& operator=(const World&) = delete;
+
         Entity newEntity() {
             return _impl.newEntity();
         }
@@ -124,7 +480,46 @@ namespace ecs {
             return _impl.buildFilter();
         }
 
-        [[nodiscard]] const std::set<Entity> & entities() const {
+        // Creates count entities with the components of the prefab in one go, then calls
+        // init(entity, index) for each of them to set what differs from the defaults.
+        // The entities join the filters at the next update, same as the ones made one by one.
+        // Parked instances of a recycled prefab are taken first, reset to the defaults.
+        template<typename F>
+        void instantiate(const Prefab& prefab, size_t count, F&& init) {
+            _impl.instantiate(prefab, count, std::forward<F>(init));
+        }
+
+        // Calls observer(entities) at every update with the entities that got a T since the last one,
+        // once the filters have them. Instances of a prefab with a T count, taken back parked ones too.
+        template<typename T>
+        void onAdd(std::function<void(const Entities&)> observer) {
+            _impl.observe(createType<T>(), std::move(observer), _impl._addObserved, _impl._onAdd, _impl._added);
+        }
+
+        // Calls observer(entities) at every update with the entities that lost a T since the last one.
+        // The pool still has the removed components during the call, get reads them, and a deleted
+        // entity is still in the filters. A component added back before the update is not reported.
+        // Parked instances keep the components of their prefab and report only the others.
+        template<typename T>
+        void onRemove(std::function<void(const Entities&)> observer) {
+            _impl.observe(createType<T>(), std::move(observer), _impl._removeObserved, _impl._onRemove, _impl._removed);
+        }
+
+        // A disabled entity keeps its components but leaves every filter at the next update
+        void disable(const Entity &entity) {
+            _impl.setEnabled(entity, false);
+        }
+
+        void enable(const Entity &entity) {
+            _impl.setEnabled(entity, true);
+        }
+
+        [[nodiscard]] bool isEnabled(const Entity &entity) const {
+            return _impl.isEnabled(entity);
+        }
+
+        // alive entities in no particular order
+        [[nodiscard]] const Entities & entities() const {
             return _impl._entities;
         }
 
@@ -132,10 +527,50 @@ namespace ecs {
             _impl.update();
         }
 
+        // Brackets a system run, lastRunTick - what beginSystem returned when the same system ran the
+        // last time, 0 if it never did. Changes are reported relative to it, the ones made outside of
+        // the system stamped with a later tick, so every system sees them.
+        Tick beginSystem(Tick lastRunTick) {
+            _impl._lastRunTick = lastRunTick;
+            return _impl._tick;
+        }
+
+        void endSystem() {
+            ++_impl._tick;
+        }
+
+        [[nodiscard]] Tick tick() const {
+            return _impl.tick();
+        }
+
+        // distinct filters the world keeps up to date
+        [[nodiscard]] size_t filterCount() const {
+            return _impl._filters.size();
+        }
+
+        // allocations made by the bookkeeping of every world so far
+        [[nodiscard]] static size_t allocations() {
+            return worldAllocations.load(std::memory_order_relaxed);
+        }
+
         template<typename T>
         std::shared_ptr<Pool<T>> pool() {
             return _impl.pool<T>();
         }
+
+        // Adds the single T of the world made from args, for state that belongs to no entity.
+        // Throws if the world has one already.
+        template<typename T, typename... Args>
+        std::shared_ptr<T> addResource(Args&&... args) {
+            return _impl.addResource<T>(std::forward<Args>(args)...);
+        }
+
+        // The single T of the world, default made on the first call. Systems keep the pointer
+        // from init like they keep pools, no filter finds it.
+        template<typename T>
+        std::shared_ptr<T> resource() {
+            return _impl.resource<T>();
+        }
     };
 }
 
@@ -0,0 +1,59 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef INTROECS_CAMERA_H
+#define INTROECS_CAMERA_H
+
+#include <cmath>
+
+#include "../data/vector2.h"
+#include "config/config.h"
+
+// Visible part of the world. The world wraps around its edges, so everything the camera shows
+// is drawn at the image of its position closest to the camera center.
+struct Camera {
+    Vector2 center;
+    Vector2 size;
+    Vector2 world;
+
+    [[nodiscard]] Vector2 min() const { return center - size * 0.5f; }
+
+    [[nodiscard]] Vector2 max() const { return center + size * 0.5f; }
+
+    // shortest displacement from one world position to another, possibly across the seam
+    [[nodiscard]] Vector2 delta(const Vector2 &from, const Vector2 &to) const {
+        auto d = to - from;
+        return {
+                d.x - world.x * std::round(d.x / world.x),
+                d.y - world.y * std::round(d.y / world.y)
+        };
+    }
+
+    [[nodiscard]] Vector2 nearestImage(const Vector2 &position) const {
+        return center + delta(center, position);
+    }
+
+    [[nodiscard]] Vector2 wrap(const Vector2 &position) const {
+        return {
+                position.x - world.x * std::floor(position.x / world.x),
+                position.y - world.y * std::floor(position.y / world.y)
+        };
+    }
+
+    [[nodiscard]] bool isVisible(const Vector2 &position, float radius) const {
+        auto d = delta(center, position);
+        return std::abs(d.x) < size.x * 0.5f + radius && std::abs(d.y) < size.y * 0.5f + radius;
+    }
+
+    static Camera create(const Config &config) {
+        auto world = Vector2(config.world.width, config.world.height);
+        return {
+                world * 0.5f,
+                Vector2(float(config.window.width), float(config.window.height)),
+                world
+        };
+    }
+};
+
+#endif //INTROECS_CAMERA_H
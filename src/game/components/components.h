@@ -7,22 +7,20 @@
 #include "asteroid_spawner_tag.h"
 #include "projectile_tag.h"
 #include "asteroid_tag.h"
-#include "fragment_tag.h"
 #include "player_tag.h"
 
 #include "text.h"
 #include "mass.h"
-#include "shape.h"
+#include "geometry.h"
+#include "render_layer.h"
 #include "speed.h"
 #include "input.h"
 #include "score.h"
-#include "drawable.h"
 #include "lifespan.h"
 #include "cooldown.h"
 #include "collider.h"
 #include "velocity.h"
 #include "transform.h"
-#include "collision_hit.h"
 
 
 #endif //ECS_COMPONENTS_H
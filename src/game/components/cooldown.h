@@ -9,7 +9,7 @@
 
 struct CCooldown
 {
-    const float total = 0;
+    float total = 0;
     float current = 0;
 
     CCooldown(float total)
@@ -1,11 +0,0 @@
-//
-// Created by Anton Kukhlevskyi on 2024-01-31.
-//
-
-#ifndef ECS_FRAGMENT_TAG_H
-#define ECS_FRAGMENT_TAG_H
-
-struct CFragmentTag {
-};
-
-#endif //ECS_FRAGMENT_TAG_H
@@ -0,0 +1,21 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef ECS_GEOMETRY_H
+#define ECS_GEOMETRY_H
+
+#include "SFML/Graphics.hpp"
+
+#include "../../render/geometry_library.h"
+
+// Shared outline from the geometry library, scaled by CTransform::scale and tinted per entity
+struct CGeometry
+{
+    render::GeometryId id = 0;
+    sf::Color fillColor;
+    sf::Color outlineColor;
+    float outlineThickness = 0;
+};
+
+#endif //ECS_GEOMETRY_H
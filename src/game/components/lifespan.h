@@ -9,7 +9,7 @@
 
 struct CLifespan
 {
-    const float total = 0;
+    float total = 0;
     float current = 0;
 
     CLifespan(float total)
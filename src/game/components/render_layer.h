@@ -0,0 +1,22 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef ECS_RENDER_LAYER_H
+#define ECS_RENDER_LAYER_H
+
+#include <cstdint>
+
+// Draw order of a geometry, higher layers are drawn on top. Geometries without it are on layer 0.
+// The HUD and the dev GUI are drawn after every layer.
+struct CRenderLayer
+{
+    static constexpr uint8_t ASTEROIDS = 0;
+    static constexpr uint8_t FRAGMENTS = 1;
+    static constexpr uint8_t PROJECTILES = 2;
+    static constexpr uint8_t PLAYER = 3;
+
+    uint8_t value = 0;
+};
+
+#endif //ECS_RENDER_LAYER_H
@@ -7,6 +7,7 @@
 
 #include <iostream>
 
+// kept as a world resource, there is one score and no entity owns it
 struct CScore
 {
     uint value = 0;
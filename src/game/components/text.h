@@ -5,14 +5,12 @@
 #ifndef ECS_TEXT_H
 #define ECS_TEXT_H
 
-#include "SFML/Graphics.hpp"
-
-#include "../../data/vector2.h"
-#include "../../data/color.h"
+#include "../../render/resource_pool.h"
 
+// HUD text, the sf::Text itself lives in the game's text pool
 struct CText
 {
-    std::shared_ptr<sf::Text> value = nullptr;
+    render::ResourceHandle value;
 };
 
 #endif //ECS_TEXT_H
@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include "../../data/vector2.h"
+#include "../../ecs/soa.h"
 
 struct CTransform
 {
@@ -32,4 +33,58 @@ struct CTransform
     }
 };
 
+// what a mutable get of the transform pool returns, the fields live in its columns
+struct CTransformRef
+{
+    Vector2Ref position;
+    float& rotation;
+    float& scale;
+
+    CTransformRef(float& x, float& y, float& rotation, float& scale)
+    : position(x, y)
+    , rotation(rotation)
+    , scale(scale)
+    {
+    }
+
+    CTransformRef& operator=(const CTransform& transform) {
+        position = transform.position;
+        rotation = transform.rotation;
+        scale = transform.scale;
+        return *this;
+    }
+
+    CTransformRef& operator=(const CTransformRef& transform) { return *this = CTransform(transform); }
+
+    operator CTransform() const { return CTransform(position, rotation, scale); }
+
+    Vector2 forward() const { return Vector2(0, -1).rotate(rotation); }
+};
+
+namespace ecs {
+    template <>
+    struct SoaLayout<CTransform> {
+        static constexpr bool ENABLED = true;
+
+        enum Column { X, Y, ROTATION, SCALE, COLUMNS };
+
+        typedef CTransformRef Ref;
+
+        static void store(const CTransform& transform, Columns<COLUMNS>& columns, size_t index) {
+            columns[X][index] = transform.position.x;
+            columns[Y][index] = transform.position.y;
+            columns[ROTATION][index] = transform.rotation;
+            columns[SCALE][index] = transform.scale;
+        }
+
+        static CTransform load(const Columns<COLUMNS>& columns, size_t index) {
+            return CTransform(Vector2(columns[X][index], columns[Y][index]), columns[ROTATION][index], columns[SCALE][index]);
+        }
+
+        static Ref ref(Columns<COLUMNS>& columns, size_t index) {
+            return { columns[X][index], columns[Y][index], columns[ROTATION][index], columns[SCALE][index] };
+        }
+    };
+}
+
 #endif //ECS_TRANSFORM_H
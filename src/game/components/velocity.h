@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include "../../data/vector2.h"
+#include "../../ecs/soa.h"
 
 struct CRotationVelocity {
     float value;
@@ -35,4 +36,87 @@ struct CVelocity
     }
 };
 
+// what mutable gets of the velocity pools return, the fields live in their columns
+struct CRotationVelocityRef {
+    float& value;
+
+    explicit CRotationVelocityRef(float& value)
+    : value(value)
+    {
+    }
+
+    CRotationVelocityRef& operator=(const CRotationVelocity& velocity) {
+        value = velocity.value;
+        return *this;
+    }
+
+    CRotationVelocityRef& operator=(const CRotationVelocityRef& velocity) { return *this = CRotationVelocity(velocity); }
+
+    operator CRotationVelocity() const { return { value }; }
+};
+
+struct CVelocityRef
+{
+    Vector2Ref value;
+
+    CVelocityRef(float& x, float& y)
+    : value(x, y)
+    {
+    }
+
+    CVelocityRef& operator=(const CVelocity& velocity) {
+        value = velocity.value;
+        return *this;
+    }
+
+    CVelocityRef& operator=(const CVelocityRef& velocity) { return *this = CVelocity(velocity); }
+
+    operator CVelocity() const { return CVelocity(Vector2(value)); }
+};
+
+namespace ecs {
+    template <>
+    struct SoaLayout<CRotationVelocity> {
+        static constexpr bool ENABLED = true;
+
+        enum Column { VALUE, COLUMNS };
+
+        typedef CRotationVelocityRef Ref;
+
+        static void store(const CRotationVelocity& velocity, Columns<COLUMNS>& columns, size_t index) {
+            columns[VALUE][index] = velocity.value;
+        }
+
+        static CRotationVelocity load(const Columns<COLUMNS>& columns, size_t index) {
+            return { columns[VALUE][index] };
+        }
+
+        static Ref ref(Columns<COLUMNS>& columns, size_t index) {
+            return Ref(columns[VALUE][index]);
+        }
+    };
+
+    template <>
+    struct SoaLayout<CVelocity> {
+        static constexpr bool ENABLED = true;
+
+        enum Column { X, Y, COLUMNS };
+
+        typedef CVelocityRef Ref;
+
+        static void store(const CVelocity& velocity, Columns<COLUMNS>& columns, size_t index) {
+            columns[X][index] = velocity.value.x;
+            columns[Y][index] = velocity.value.y;
+        }
+
+        static CVelocity load(const Columns<COLUMNS>& columns, size_t index) {
+            return { columns[X][index], columns[Y][index] };
+        }
+
+        static Ref ref(Columns<COLUMNS>& columns, size_t index) {
+            return { columns[X][index], columns[Y][index] };
+        }
+    };
+}
+
 #endif //ECS_VELOCITY_H
@@ -14,14 +14,21 @@ Config::readFromFile(const std::string &configPath) {
     std::shared_ptr<sf::Font> font = std::make_shared<sf::Font>();
     font->loadFromFile(iniConfig.get("Font", "path", "./sofachrome.otf"));
 
+    auto windowWidth = iniConfig.get("Window", "width", 800u);
+    auto windowHeight = iniConfig.get("Window", "height", 600u);
+
     return {
             .window {
                     iniConfig.get("Window", "name", ""),
-                    iniConfig.get("Window", "width", 800u),
-                    iniConfig.get("Window", "height", 600u),
+                    windowWidth,
+                    windowHeight,
                     iniConfig.get("Window", "frame_rate", 60u),
                     iniConfig.get("Window", "fullscreen", false) ? sf::Style::Fullscreen : sf::Style::Default
             },
+            .world {
+                    iniConfig.get("World", "width", float(windowWidth)),
+                    iniConfig.get("World", "height", float(windowHeight)),
+            },
             .font {
                     font,
                     iniConfig.get("Font", "size", 24u),
@@ -30,6 +37,7 @@ Config::readFromFile(const std::string &configPath) {
             .gameplay {
                     iniConfig.get("Gameplay", "spawn_cooldown", 100.0f),
                     iniConfig.get("Gameplay", "spawn_max_alive", 10u),
+                    iniConfig.get("Gameplay", "spawn_safe_distance", 150.f),
             },
             .player {
                     iniConfig.get("Player", "radius", 10.0f),
@@ -51,6 +59,7 @@ Config::readFromFile(const std::string &configPath) {
                     iniConfig.get("Asteroid", "fill_color", Color(255, 200, 200)),
                     iniConfig.get("Asteroid", "outline_color", Color(255, 200, 200)),
                     iniConfig.get("Asteroid", "outline_thickness", 3.0f),
+                    iniConfig.get("Asteroid", "shape_variants", 8u),
             },
             .projectile {
                     iniConfig.get("Projectile", "radius", 5.f),
@@ -67,6 +76,20 @@ Config::readFromFile(const std::string &configPath) {
                     iniConfig.get("Fragment", "outline_color", Color(255, 200, 200)),
                     iniConfig.get("Fragment", "outline_thickness", 60.f),
                     iniConfig.get("Fragment", "lifespan", 60.f),
+                    iniConfig.get("Fragment", "capacity", 4096u),
+            },
+            .render {
+                    iniConfig.get("Render", "backend", std::string("window")),
+                    iniConfig.get("Render", "record_path", std::string("./frames.rec")),
+                    iniConfig.get("Render", "headless_frames", 3600u),
+                    iniConfig.get("Render", "dump_every", 0u),
+                    iniConfig.get("Render", "dump_path", std::string("./frame_")),
+            },
+            .lod {
+                    iniConfig.get("Lod", "simplify_radius", 8.f),
+                    iniConfig.get("Lod", "fill_radius", 4.f),
+                    iniConfig.get("Lod", "frame_budget", 12.f),
+                    iniConfig.get("Lod", "max_boost", 4.f),
             }
     };
 }
\ No newline at end of file
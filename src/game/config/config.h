@@ -17,6 +17,12 @@ struct Config {
         uint32_t style;
     };
 
+    // playfield wrapping around its edges, the window shows the part of it around the player
+    struct World {
+        float width;
+        float height;
+    };
+
     struct Font {
         std::shared_ptr<sf::Font> font;
         uint size;
@@ -26,6 +32,7 @@ struct Config {
     struct Gameplay {
         float spawnCooldown;
         uint spawnMaxAlive;
+        float spawnSafeDistance;
     };
 
     struct Player {
@@ -49,6 +56,7 @@ struct Config {
         Color fillColor;
         Color outlineColor;
         float outlineThickness;
+        uint shapeVariants;
     };
 
     struct Projectile {
@@ -66,15 +74,35 @@ struct Config {
         Color outlineColor;
         float outlineThickness;
         float lifespan;
+        uint capacity;
+    };
+
+    struct Render {
+        std::string backend;        // window, software, record or null
+        std::string recordPath;
+        uint headlessFrames;        // frames simulated by the backends without a window
+        uint dumpEvery;             // frames between two software framebuffer dumps, 0 never dumps
+        std::string dumpPath;
+    };
+
+    // asteroid level of detail, radii are in pixels on screen
+    struct Lod {
+        float simplifyRadius;
+        float fillRadius;
+        float frameBudget;      // milliseconds
+        float maxBoost;
     };
 
     Window window;
+    World world;
     Font font;
     Gameplay gameplay;
     Player player;
     Asteroid asteroid;
     Projectile projectile;
     Fragment fragment;
+    Render render;
+    Lod lod;
 
     static Config readFromFile(const std::string& iniPath);
 };
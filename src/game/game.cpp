@@ -1,13 +1,20 @@
 //
 // Created by Anton Kukhlevskyi on 2024-02-04.
 //
+#include <filesystem>
 #include <memory>
+#include <stdexcept>
+#include <string>
 
 #include "../data/color.h"
 #include "../data/vector2.h"
 
 #include "game.h"
 
+#include "../render/recording.h"
+#include "../render/sfml_backend.h"
+#include "../render/software_backend.h"
+
 #include "systems/input_system.h"
 #include "systems/draw_system.h"
 #include "systems/spawn_player_system.h"
@@ -18,9 +25,12 @@
 #include "systems/rotate_system.h"
 #include "systems/move_system.h"
 #include "systems/update_shape_transform_system.h"
+#include "systems/follow_camera_system.h"
 #include "systems/cooldown_tick_system.h"
 #include "systems/lifespan_tick_system.h"
 #include "systems/lifespan_fade_system.h"
+#include "systems/update_particles_system.h"
+#include "systems/update_spatial_index_system.h"
 #include "systems/collide_system.h"
 #include "systems/destroy_asteroid_system.h"
 #include "systems/destroy_player_system.h"
@@ -28,34 +38,61 @@
 #include "systems/score_system.h"
 #include "systems/dev_gui_system.h"
 
-Game::Game(const std::string& configPath) noexcept
+static std::unique_ptr<render::IBackend> createRenderBackend(const Config& config, sf::RenderWindow& window, const Geometries& geometries, JobSystem& jobs) {
+    if (config.render.backend == "null") return std::make_unique<render::NullBackend>();
+    if (config.render.backend == "record") return std::make_unique<render::RecordingBackend>(config.render.recordPath);
+    if (config.render.backend == "software") {
+        return std::make_unique<render::SoftwareBackend>(geometries.library, jobs, config.window.width, config.window.height,
+                                                         config.render.dumpEvery, config.render.dumpPath);
+    }
+    return std::make_unique<render::SfmlBackend>(window, geometries.library, jobs);
+}
+
+// Most entities alive at once: the asteroids, the projectiles in flight, the player, the score and
+// the spawner, twice for the ones deleted and created in the same frame
+static size_t expectedEntities(const Config& config) {
+    auto projectiles = size_t(config.projectile.lifespan / std::max(config.player.shootCooldown, 1.f)) + 1;
+    return 2 * (config.gameplay.spawnMaxAlive + projectiles + 3);
+}
+
+Game::Game(const std::string& configPath)
 : _config(std::move(Config::readFromFile(configPath)))
+, _geometries(Geometries::create(_config))
+, _prefabs(Prefabs::readFromFile(std::filesystem::path(configPath).replace_filename("prefabs.ini").string()))
+, _camera(Camera::create(_config))
+, _renderBackend(createRenderBackend(_config, _window, _geometries, _jobs))
+, _lod(_config.lod.simplifyRadius, _config.lod.fillRadius, _config.lod.frameBudget, _config.lod.maxBoost)
+, _fragments(_config.fragment.capacity, _config.fragment.fillColor(), _config.fragment.outlineColor(), _config.fragment.outlineThickness)
+, _world(expectedEntities(_config))
 , _systems(std::move(
         ecs::Systems::builder()
             .add(std::make_shared<InputSystem>())
-            .add(std::make_shared<ScoreSystem>(_config))
+            .add(std::make_shared<ScoreSystem>(_config, _texts))
 
-            .add(std::make_shared<SpawnPlayerSystem>(_config))
-            .add(std::make_shared<SpawnAsteroidSystem>(_config))
+            .add(std::make_shared<SpawnPlayerSystem>(_config, _geometries, _prefabs.player))
+            .add(std::make_shared<SpawnAsteroidSystem>(_config, _geometries, _spatialIndex, _camera, _prefabs.asteroid))
 
             .add(std::make_shared<SpinPlayerSystem>())
             .add(std::make_shared<MovePlayerSystem>())
-            .add(std::make_shared<ShootPlayerSystem>(_config))
+            .add(std::make_shared<ShootPlayerSystem>(_config, _geometries, _prefabs.projectile))
 
             .add(std::make_shared<RotateSystem>())
             .add(std::make_shared<MoveSystem>())
 
             // Physics
-            .add(std::make_shared<CollideSystem>())
-            .add(std::make_shared<DestroyAsteroidSystem>(_config))
-            .add(std::make_shared<DestroyPlayerSystem>(_config))
-            .add(std::make_shared<DestroyProjectileSystem>())
+            .add(std::make_shared<UpdateSpatialIndexSystem>(_config, _spatialIndex))
+            .add(std::make_shared<CollideSystem>(_spatialIndex, _contacts, _jobs))
+            .add(std::make_shared<DestroyAsteroidSystem>(_config, _geometries, _contacts, _fragments))
+            .add(std::make_shared<DestroyPlayerSystem>(_config, _geometries, _contacts, _fragments))
+            .add(std::make_shared<DestroyProjectileSystem>(_contacts))
 
             .add(std::make_shared<UpdateShapeTransformSystem>(_config))
+            .add(std::make_shared<FollowCameraSystem>(_camera))
             .add(std::make_shared<LifespanFadeSystem>())
+            .add(std::make_shared<UpdateParticlesSystem>(_config, _fragments))
 
-            .add(std::make_shared<DrawSystem>(_window))
-            .add(std::make_shared<DevGuiSystem>(_window, _systems))
+            .add(std::make_shared<DrawSystem>(_window, *_renderBackend, _geometries.library, _lod, _spatialIndex, _fragments, _camera, _texts))
+            .add(std::make_shared<DevGuiSystem>(_window, _systems, _fragments))
 
             .add(std::make_shared<CooldownTickSystem>())
             .add(std::make_shared<LifespanTickSystem>())
@@ -65,11 +102,25 @@ Game::Game(const std::string& configPath) noexcept
 }
 
 void Game::run() {
-    _window.create({ _config.window.width, _config.window.height }, _config.window.name, _config.window.style);
-    _window.setFramerateLimit(_config.window.frameRate);
+    auto headless = _config.render.backend != "window";
+    if (!headless) {
+        _window.create({ _config.window.width, _config.window.height }, _config.window.name, _config.window.style);
+        _window.setFramerateLimit(_config.window.frameRate);
+    }
 
     _systems.init(_world);
+    if (headless) {
+        runHeadless();
+    } else {
+        runWindow();
+    }
+    _systems.dispose(_world);
+}
+
+void Game::runWindow() {
+    sf::Clock frameClock;
     while (_window.isOpen()) {
+        frameClock.restart();
         while(_window.pollEvent(_event)) {
             if (_event.type == sf::Event::Closed) _window.close();
 
@@ -83,10 +134,38 @@ void Game::run() {
         _window.clear();
 
         _systems.render(_world);
+        // display() waits for the frame rate limit, the level of detail only cares about the work
+        _lod.frame(frameClock.getElapsedTime().asSeconds() * 1000.f);
 
         _window.display();
 
     }
+}
 
-    _systems.dispose(_world);
-}
\ No newline at end of file
+// No window and no input, a fixed number of frames with a fixed time step as fast as possible
+void Game::runHeadless() {
+    auto dt = sf::seconds(1.f / float(_config.window.frameRate));
+    sf::Clock clock;
+    sf::Clock frameClock;
+    size_t warmAllocations = 0;
+    for (uint frame = 0; frame < _config.render.headlessFrames; ++frame) {
+        // the first frame spawns the player and sets the prefabs up
+        if (frame == 1) warmAllocations = ecs::World::allocations();
+
+        frameClock.restart();
+        _systems.run(_world, dt);
+        _systems.render(_world);
+        _lod.frame(frameClock.getElapsedTime().asSeconds() * 1000.f);
+    }
+
+    auto elapsed = clock.getElapsedTime().asSeconds();
+    std::cout << _config.render.headlessFrames << " frames with the " << _config.render.backend << " backend in "
+              << elapsed << " s, " << elapsed * 1000.f / float(std::max(_config.render.headlessFrames, 1u)) << " ms per frame" << std::endl;
+
+    // the world reserves for expectedEntities, past the first frame its bookkeeping should not allocate
+    auto steadyAllocations = _config.render.headlessFrames > 1 ? ecs::World::allocations() - warmAllocations : 0;
+    std::cout << steadyAllocations << " world allocations after the first frame" << std::endl;
+    if (steadyAllocations != 0) {
+        throw std::runtime_error(std::to_string(steadyAllocations) + " world allocations in steady frames");
+    }
+}
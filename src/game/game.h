@@ -10,23 +10,51 @@
 
 #include "../ecs/world.h"
 #include "../ecs/systems.h"
+#include "../particles/particle_pool.h"
+#include "../physics/contact.h"
+#include "../physics/spatial_index.h"
+#include "../render/backend.h"
+#include "../render/lod_policy.h"
+#include "../render/resource_pool.h"
+#include "../utils/job_system.h"
+#include "camera.h"
 #include "config/config.h"
+#include "geometries.h"
+#include "prefabs.h"
 
 class Game {
 private:
+    // the score is the only HUD text for now
+    static constexpr size_t TEXT_CAPACITY = 4;
+
     Config _config {};
+    Geometries _geometries {};
+    Prefabs _prefabs {};
+    Camera _camera {};
     sf::Event _event {};
     sf::Clock _deltaClock {};
 
     sf::RenderWindow _window;
+    JobSystem _jobs;
+    std::unique_ptr<render::IBackend> _renderBackend;
+    render::LodPolicy _lod;
+    render::ResourcePool<sf::Text> _texts { TEXT_CAPACITY };
+
+    physics::SpatialIndex _spatialIndex;
+    physics::Contacts _contacts;
+    particles::ParticlePool _fragments;
 
     ecs::World _world;
     ecs::Systems _systems;
 
 public:
-    explicit Game(const std::string& configPath) noexcept;
+    explicit Game(const std::string& configPath);
 
     void run();
+
+private:
+    void runWindow();
+    void runHeadless();
 };
 
 
@@ -0,0 +1,64 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "geometries.h"
+
+static float randomRange(float min, float max) {
+    return min + (max - min) * float(std::rand()) / float(RAND_MAX);
+}
+
+render::GeometryId
+Geometries::fragment(uint pointCount) const {
+    auto index = std::clamp<int>(int(pointCount) - int(fragmentMinPoints), 0, int(fragments.size()) - 1);
+    return fragments[index];
+}
+
+render::GeometryId
+Geometries::asteroid(uint pointCount, uint variant) const {
+    auto counts = asteroids.size() / asteroidVariants;
+    auto index = std::clamp<int>(int(pointCount) - int(asteroidMinPoints), 0, int(counts) - 1);
+    return asteroids[index * asteroidVariants + variant % asteroidVariants];
+}
+
+Geometries
+Geometries::create(const Config &config) {
+    Geometries geometries;
+
+    geometries.player = geometries.library.add({
+            { 0.f, -1.f },
+            { 0.7f, 1.f },
+            { 0.f, 0.5f },
+            { -0.7f, 1.f },
+    });
+
+    geometries.projectile = geometries.library.add(render::GeometryLibrary::polygon(5));
+
+    // fragments are triangles and quads
+    for (uint pointCount = geometries.fragmentMinPoints; pointCount <= 4; ++pointCount) {
+        geometries.fragments.push_back(geometries.library.add(render::GeometryLibrary::polygon(pointCount)));
+    }
+
+    // asteroids have one point per unit of mass, every point is pushed in or out a bit
+    geometries.asteroidMinPoints = std::max(uint(config.asteroid.massMin), 3u);
+    geometries.asteroidVariants = std::max(config.asteroid.shapeVariants, 1u);
+    auto asteroidMaxPoints = std::max(uint(config.asteroid.massMax), geometries.asteroidMinPoints);
+
+    for (auto pointCount = geometries.asteroidMinPoints; pointCount <= asteroidMaxPoints; ++pointCount) {
+        for (uint variant = 0; variant < geometries.asteroidVariants; ++variant) {
+            auto points = render::GeometryLibrary::polygon(pointCount);
+            for (auto &point: points) {
+                point = point * randomRange(0.7f, 1.3f);
+            }
+            auto id = geometries.library.add(points);
+            // half of the points for the lower levels of detail
+            geometries.library.addSimplified(id, (pointCount + 1) / 2);
+            geometries.asteroids.push_back(id);
+        }
+    }
+
+    return geometries;
+}
@@ -0,0 +1,35 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef INTROECS_GEOMETRIES_H
+#define INTROECS_GEOMETRIES_H
+
+#include <vector>
+
+#include "../render/geometry_library.h"
+#include "config/config.h"
+
+// Every outline the game draws, generated once at start with a radius of 1.
+// Entities pick one by id and set their size through CTransform::scale.
+struct Geometries {
+    render::GeometryLibrary library;
+
+    render::GeometryId player = 0;
+    render::GeometryId projectile = 0;
+
+    uint fragmentMinPoints = 3;
+    std::vector<render::GeometryId> fragments;
+
+    uint asteroidMinPoints = 0;
+    uint asteroidVariants = 1;
+    std::vector<render::GeometryId> asteroids;
+
+    [[nodiscard]] render::GeometryId fragment(uint pointCount) const;
+
+    [[nodiscard]] render::GeometryId asteroid(uint pointCount, uint variant) const;
+
+    static Geometries create(const Config& config);
+};
+
+#endif //INTROECS_GEOMETRIES_H
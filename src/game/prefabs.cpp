@@ -0,0 +1,73 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "prefabs.h"
+#include "components/components.h"
+
+#include "../ini/ini_config.h"
+
+typedef void (*ComponentReader)(ecs::Prefab& prefab, const IniConfig& iniConfig, const std::string& section, const std::string& key);
+
+// components without data, listed as "name = true"
+template<typename T>
+static void readTag(ecs::Prefab& prefab, const IniConfig& iniConfig, const std::string& section, const std::string& key) {
+    if (iniConfig.get(section, key, false)) prefab.with<T>();
+}
+
+// components with a single value, listed as "name = default value"
+template<typename T, typename V>
+static void readValue(ecs::Prefab& prefab, const IniConfig& iniConfig, const std::string& section, const std::string& key) {
+    prefab.with(T { iniConfig.get(section, key, V()) });
+}
+
+// every component a prefab can list, by its name in the file
+static const std::vector<std::pair<std::string, ComponentReader>> COMPONENTS = {
+        { "player_tag", readTag<CPlayerTag> },
+        { "asteroid_tag", readTag<CAsteroidTag> },
+        { "projectile_tag", readTag<CProjectileTag> },
+        { "input", readTag<CInput> },
+        { "geometry", readTag<CGeometry> },
+        { "velocity", readTag<CVelocity> },
+        { "transform", [](ecs::Prefab& prefab, const IniConfig& iniConfig, const std::string& section, const std::string& key) {
+            if (iniConfig.get(section, key, false)) prefab.with(CTransform(Vector2(0, 0)));
+        } },
+        { "render_layer", [](ecs::Prefab& prefab, const IniConfig& iniConfig, const std::string& section, const std::string& key) {
+            prefab.with(CRenderLayer { uint8_t(iniConfig.get(section, key, 0u)) });
+        } },
+        { "collider", readValue<CCollider, float> },
+        { "mass", readValue<CMass, uint> },
+        { "rotation_velocity", readValue<CRotationVelocity, float> },
+        { "move_speed", readValue<CMoveSpeed, float> },
+        { "move_acceleration", readValue<CMoveAcceleration, float> },
+        { "spin_speed", readValue<CSpinSpeed, float> },
+        { "lifespan", readValue<CLifespan, float> },
+};
+
+static ecs::Prefab readPrefab(const IniConfig& iniConfig, const std::string& iniPath, const std::string& name) {
+    if (!iniConfig.hasSection(name)) {
+        throw std::runtime_error("No prefab " + name + " in " + iniPath);
+    }
+
+    ecs::Prefab prefab(name);
+    prefab.recycled(iniConfig.get(name, "recycle", false));
+    for (const auto& [key, read] : COMPONENTS) {
+        if (iniConfig.hasKey(name, key)) read(prefab, iniConfig, name, key);
+    }
+    return prefab;
+}
+
+Prefabs
+Prefabs::readFromFile(const std::string &iniPath) {
+    IniConfig iniConfig(iniPath);
+
+    return {
+            readPrefab(iniConfig, iniPath, "Player"),
+            readPrefab(iniConfig, iniPath, "Asteroid"),
+            readPrefab(iniConfig, iniPath, "Projectile"),
+    };
+}
@@ -0,0 +1,22 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef INTROECS_PREFABS_H
+#define INTROECS_PREFABS_H
+
+#include <string>
+
+#include "../ecs/prefab.h"
+
+// Components every spawned entity of a kind starts with, read from prefabs.ini next to the config.
+// The spawn systems instantiate them and fill in what comes from the config or the situation.
+struct Prefabs {
+    ecs::Prefab player;
+    ecs::Prefab asteroid;
+    ecs::Prefab projectile;
+
+    static Prefabs readFromFile(const std::string& iniPath);
+};
+
+#endif //INTROECS_PREFABS_H
@@ -10,87 +10,87 @@
 #include "../../data/color.h"
 #include "../../data/vector2.h"
 #include "../../ecs/systems.h"
+#include "../../physics/contact.h"
+#include "../../physics/spatial_index.h"
+#include "../../utils/job_system.h"
 #include "../../utils/utils.h"
 
-class CollideSystem : public ecs::IInitSystem, public ecs::IRunSystem {
+class CollideSystem : public ecs::IRunSystem {
 private:
     const std::string _name = "CollideSystem";
 
-    std::shared_ptr<ecs::Filter> _filter;
+    // below this many colliders waking the workers costs more than the work itself
+    static constexpr size_t PARALLEL_MIN_COLLIDERS = 256;
 
-    std::shared_ptr<ecs::Pool<CCollisionHit>> _collisionHitPool;
-    std::shared_ptr<ecs::Pool<CCollider>> _colliderPool;
-    std::shared_ptr<ecs::Pool<CTransform>> _transformPool;
-    std::shared_ptr<ecs::Pool<CVelocity>> _velocityPool;
+    const physics::SpatialIndex& _spatialIndex;
+    physics::Contacts& _contacts;
 
-    std::shared_ptr<ecs::Pool<CPlayerTag>> _playerTagPool;
-    std::shared_ptr<ecs::Pool<CAsteroidTag>> _asteroidTagPool;
-    std::shared_ptr<ecs::Pool<CProjectileTag>> _projectileTagPool;
+    JobSystem& _jobs;
+    std::vector<physics::Contacts> _chunkContacts;
 
 public:
-    [[nodiscard]] const std::string& name() const override { return _name; }
-
-    void init(ecs::World &world) override {
-        _transformPool = world.pool<CTransform>();
-        _velocityPool = world.pool<CVelocity>();
-        _colliderPool = world.pool<CCollider>();
-        _collisionHitPool = world.pool<CCollisionHit>();
-
-        _playerTagPool = world.pool<CPlayerTag>();
-        _asteroidTagPool = world.pool<CAsteroidTag>();
-        _projectileTagPool = world.pool<CProjectileTag>();
-
-        _filter = world.buildFilter()
-                .include<CCollider>()
-                .include<CTransform>()
-                .include<CVelocity>()
-                .build();
+    CollideSystem(const physics::SpatialIndex& spatialIndex, physics::Contacts& contacts, JobSystem& jobs)
+    : _spatialIndex(spatialIndex)
+    , _contacts(contacts)
+    , _jobs(jobs)
+    {
     }
 
+    [[nodiscard]] const std::string& name() const override { return _name; }
+
     void run(ecs::World &world, const sf::Time& dt) override {
-        for (auto entity: _filter->entities()) {
-            checkCollision(entity);
+        // every chunk owns a band of grid rows and its own contact buffer
+        auto rows = size_t(_spatialIndex.rows());
+        auto chunks = _spatialIndex.proxies().size() < PARALLEL_MIN_COLLIDERS ? 1 : std::min(_jobs.size(), rows);
+        if (_chunkContacts.size() < chunks) _chunkContacts.resize(chunks);
+
+        _jobs.parallelFor(chunks, [this, rows, chunks](size_t chunk) {
+            auto &contacts = _chunkContacts[chunk];
+            contacts.clear();
+
+            auto rowBegin = int(rows * chunk / chunks);
+            auto rowEnd = int(rows * (chunk + 1) / chunks);
+            _spatialIndex.forEachPairInRows(rowBegin, rowEnd, [&contacts](const physics::Proxy &a, const physics::Proxy &b, const Vector2 &shift) {
+                checkCollision(contacts, a, b, shift);
+            });
+        });
+
+        // sorting makes the merged list identical to a single threaded run
+        _contacts.clear();
+        for (size_t chunk = 0; chunk < chunks; ++chunk) {
+            _contacts.append(_chunkContacts[chunk]);
         }
+        _contacts.sort();
     }
 
-    void checkCollision(const ecs::Entity &entity) {
-        const auto &collider = _colliderPool->get(entity);
-        const auto &transform = _transformPool->get(entity);
-
-        // todo: iterate over nearest object
-        for (auto otherEntity: _filter->entities()) {
-            if (entity == otherEntity) continue;
-
-            const auto &otherCollider = _colliderPool->get(otherEntity);
-            const auto &otherTransform = _transformPool->get(otherEntity);
-            const auto &otherVelocity = _velocityPool->get(otherEntity);
-
-            auto actualDistance = (transform.position - otherTransform.position).magnitude();
-            auto expectedDistance = collider.value + otherCollider.value;
-
-            // check is object collided
-            if (actualDistance < expectedDistance) {
-                if (!_collisionHitPool->has(entity)) { _collisionHitPool->add(entity); }
-                auto & hit = _collisionHitPool->get(entity);
+    // Both proxies move linearly during the tick, so the test runs on the segment traced by b
+    // relative to a. Without sweeps the segment is a point and this is a plain circle test.
+    static void checkCollision(physics::Contacts &contacts, const physics::Proxy &proxy, const physics::Proxy &otherProxy, const Vector2 &shift) {
+        auto delta = otherProxy.position + shift - proxy.position;
+        auto relativeSweep = otherProxy.sweep - proxy.sweep;
+        auto expectedDistance = proxy.radius + otherProxy.radius;
+
+        auto sweepLength = relativeSweep.sqrMagnitude();
+        if (sweepLength > 0) {
+            // closest approach during the tick
+            auto start = delta - relativeSweep;
+            auto t = std::clamp(-start.dot(relativeSweep) / sweepLength, 0.f, 1.f);
+            delta = start + relativeSweep * t;
+        }
 
-                hit.velocity = otherVelocity.value;
-                hit.position = otherTransform.position;
-                hit.radius   = otherCollider.value;
-                hit.type     = toType(otherEntity);
-                hit.distance = actualDistance;
+        // check is object collided
+        if (delta.sqrMagnitude() < expectedDistance * expectedDistance) {
+            auto actualDistance = delta.magnitude();
+            auto normal = actualDistance > 0 ? delta * (1.f / actualDistance) : relativeSweep.normalized();
 
-                return;
+            // keep the lower entity first, so the contact does not depend on the grid order
+            if (proxy.entity < otherProxy.entity) {
+                contacts.add({ proxy.entity, otherProxy.entity, normal, expectedDistance - actualDistance });
+            } else {
+                contacts.add({ otherProxy.entity, proxy.entity, -normal, expectedDistance - actualDistance });
             }
         }
     }
-
-    ObjectType toType(const ecs::Entity &entity) {
-        if (_playerTagPool->has(entity)) return Player;
-        if (_asteroidTagPool->has(entity)) return Asteroid;
-        if (_projectileTagPool->has(entity)) return Projectile;
-
-        return Fragment;
-    }
 };
 
 #endif //ECS_COLLIDE_OBSTACLE_SYSTEM_H
@@ -31,7 +31,7 @@ public:
 
     void run(ecs::World& world, const sf::Time& dt) override {
         for (const auto & entity : _filter->entities()) {
-            auto & cooldown = _cooldownPool->get(entity);
+            auto & cooldown = _cooldownPool->write(entity);
 
             // todo: replace with delta time
             cooldown.current -= 1;
@@ -9,133 +9,108 @@
 #include <memory>
 #include "../../ecs/systems.h"
 #include "../components/components.h"
+#include "../geometries.h"
+#include "../../particles/particle_pool.h"
+#include "../../physics/contact.h"
 
 class DestroyAsteroidSystem : public ecs::IInitSystem, public ecs::IRunSystem {
 private:
     const std::string _name = "DestroyAsteroidSystem";
 
     const Config& _config;
+    const Geometries& _geometries;
+    const physics::Contacts& _contacts;
+    particles::ParticlePool& _fragments;
 
-    std::shared_ptr<ecs::Filter> _asteroidFilter;
-    std::shared_ptr<ecs::Filter> _scoreFilter;
-
-
-    std::shared_ptr<ecs::Pool<CCollisionHit>> _hitPool;
+    std::shared_ptr<ecs::Pool<CAsteroidTag>> _asteroidTagPool;
     std::shared_ptr<ecs::Pool<CMass>> _massPool;
 
-    std::shared_ptr<ecs::Pool<CScore>> _scorePool;
-    std::shared_ptr<ecs::Pool<CShape>> _shapePool;
-    std::shared_ptr<ecs::Pool<CDrawable>> _drawablePool;
-    std::shared_ptr<ecs::Pool<CFragmentTag>> _fragmentTagPool;
-    std::shared_ptr<ecs::Pool<CLifespan>> _lifespanPool;
-    std::shared_ptr<ecs::Pool<CTransform>> _transformPool;
+    std::shared_ptr<CScore> _score;
+    std::shared_ptr<const ecs::Pool<CTransform>> _transformPool;
     std::shared_ptr<ecs::Pool<CVelocity>> _velocityPool;
-    std::shared_ptr<ecs::Pool<CRotationVelocity>> _rotationVelocityPool;
     std::shared_ptr<ecs::Pool<CCollider>> _colliderPool;
 
+    std::vector<ecs::Entity> _destroyed;
+
 public:
-    explicit DestroyAsteroidSystem(const Config& config)
+    DestroyAsteroidSystem(const Config& config, const Geometries& geometries, const physics::Contacts& contacts,
+                          particles::ParticlePool& fragments)
     : _config(config)
+    , _geometries(geometries)
+    , _contacts(contacts)
+    , _fragments(fragments)
     {
     }
 
     [[nodiscard]] const std::string& name() const override { return _name; }
 
     void init(ecs::World &world) override {
-        _hitPool = world.pool<CCollisionHit>();
+        _asteroidTagPool = world.pool<CAsteroidTag>();
         _massPool = world.pool<CMass>();
 
         _colliderPool = world.pool<CCollider>();
-        _drawablePool = world.pool<CDrawable>();
-        _fragmentTagPool = world.pool<CFragmentTag>();
-        _lifespanPool = world.pool<CLifespan>();
-        _shapePool = world.pool<CShape>();
         _transformPool = world.pool<CTransform>();
         _velocityPool = world.pool<CVelocity>();
-        _rotationVelocityPool = world.pool<CRotationVelocity>();
-
-        _scorePool = world.pool<CScore>();
-
-        _asteroidFilter = world.buildFilter()
-                .include<CAsteroidTag>()
-                .include<CCollisionHit>()
-                .build();
 
-        _scoreFilter = world.buildFilter()
-                .include<CScore>()
-                .build();
+        _score = world.resource<CScore>();
     }
 
     void run(ecs::World &world, const sf::Time& dt) override {
-        for (const auto &asteroidEntity: _asteroidFilter->entities()) {
-            const auto &hit = _hitPool->get(asteroidEntity);
-            if (hit.type == Asteroid) {
-                bounceAsteroid(asteroidEntity);
-                _hitPool->del(asteroidEntity);
-            } else {
-                spawnFragment(world, asteroidEntity);
-                updateScore(asteroidEntity);
-                world.deleteEntity(asteroidEntity);
-            }
+        _destroyed.clear();
+        for (const auto &contact: _contacts) {
+            onContact(world, contact, contact.a);
+            onContact(world, contact, contact.b);
         }
     }
 
-    void updateScore(const ecs::Entity &asteroidEntity) {
-        for (const auto &scoreEntity: _scoreFilter->entities()) {
-            const auto &mass = _massPool->get(asteroidEntity);
-            auto &score = _scorePool->get(scoreEntity);
-
-            score.value += mass.value * 10;
+    void onContact(ecs::World &world, const physics::Contact &contact, const ecs::Entity &asteroidEntity) {
+        if (!_asteroidTagPool->has(asteroidEntity)) return;
+        // an asteroid hit by several objects during one tick is destroyed only once
+        if (std::find(_destroyed.begin(), _destroyed.end(), asteroidEntity) != _destroyed.end()) return;
+
+        auto otherEntity = contact.other(asteroidEntity);
+        if (_asteroidTagPool->has(otherEntity)) {
+            bounceAsteroid(asteroidEntity, contact.normalFrom(asteroidEntity));
+        } else {
+            spawnFragment(asteroidEntity, otherEntity);
+            updateScore(asteroidEntity);
+            world.deleteEntity(asteroidEntity);
+            _destroyed.push_back(asteroidEntity);
         }
     }
 
-    void bounceAsteroid(const ecs::Entity &asteroidEntity) {
-        const auto &hit = _hitPool->get(asteroidEntity);
+    void updateScore(const ecs::Entity &asteroidEntity) {
+        const auto &mass = _massPool->get(asteroidEntity);
+        _score->value += mass.value * 10;
+    }
 
-        auto &velocity = _velocityPool->get(asteroidEntity);
+    void bounceAsteroid(const ecs::Entity &asteroidEntity, const Vector2 &normal) {
+        auto velocity = _velocityPool->write(asteroidEntity);
 
+        // push away from the other asteroid keeping the speed
         auto velocityValue = velocity.value.magnitude();
-        auto newVelocity = hit.position.normalized() * velocityValue;
+        auto newVelocity = Vector2(-normal.x, -normal.y) * velocityValue;
 
         velocity.value = newVelocity;
     }
 
-    void spawnFragment(ecs::World &world, const ecs::Entity &asteroidEntity) {
-        const auto &hit = _hitPool->get(asteroidEntity);
-        const auto &mass = _massPool->get(asteroidEntity);
-        const auto &transform = _transformPool->get(asteroidEntity);
-        const auto &collider = _colliderPool->get(asteroidEntity);
+    void spawnFragment(const ecs::Entity &asteroidEntity, const ecs::Entity &otherEntity) {
+        const auto otherVelocity = std::as_const(*_velocityPool).get(otherEntity);
+        // copies, the fragments go into the same pools
+        const auto mass = std::as_const(*_massPool).get(asteroidEntity);
+        const auto transform = std::as_const(*_transformPool).get(asteroidEntity);
+        const auto collider = std::as_const(*_colliderPool).get(asteroidEntity);
 
-        auto otherVelocityNormalized = hit.velocity.normalized();
+        auto otherVelocityNormalized = otherVelocity.value.normalized();
         auto angleStep = 360.f / float(mass.value);
         for (int i = 0; i < mass.value; ++i) {
-            auto entity = world.newEntity();
-
             auto forward = otherVelocityNormalized.rotate(float(i) * angleStep);
             auto position = transform.position + forward * collider.value;
-            auto shape = createShape(position);
-
-            _fragmentTagPool->add(entity);
-            _shapePool->add(entity, { shape });
-            _drawablePool->add(entity, { shape });
-            _transformPool->add(entity, CTransform(position));
-            _lifespanPool->add(entity, {_config.projectile.lifespan});
-            _velocityPool->add(entity, {forward * _config.fragment.speed});
-            _rotationVelocityPool->add(entity, {_config.fragment.rotationSpeed});
-        }
-    }
 
-    std::shared_ptr<sf::CircleShape> createShape(Vector2 position) {
-        auto shape = std::make_shared<sf::CircleShape>(_config.fragment.radius, random(3, 5));
-        shape->setPosition(position());
-        shape->setFillColor(_config.fragment.fillColor());
-        shape->setOutlineColor(_config.fragment.outlineColor());
-        shape->setOutlineThickness(_config.fragment.outlineThickness);
-        shape->setOrigin(0.5f, 0.5f);
-        return shape;
+            _fragments.emit(position, forward * _config.fragment.speed, _config.fragment.rotationSpeed,
+                            _config.fragment.radius, _geometries.fragment(random(3u, 5u)), uint32_t(_config.fragment.lifespan));
+        }
     }
-
-
 };
 
 #endif //ECS_DESTROY_ASTEROID_SYSTEM_H
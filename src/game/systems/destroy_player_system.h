@@ -9,109 +9,88 @@
 #include <memory>
 #include "../../ecs/systems.h"
 #include "../components/components.h"
+#include "../geometries.h"
 #include "../config/config.h"
+#include "../../particles/particle_pool.h"
+#include "../../physics/contact.h"
 
 class DestroyPlayerSystem : public ecs::IInitSystem, public ecs::IRunSystem {
 private:
     const std::string _name = "DestroyPlayerSystem";
     const Config& _config;
+    const Geometries& _geometries;
+    const physics::Contacts& _contacts;
+    particles::ParticlePool& _fragments;
 
-    std::shared_ptr<ecs::Filter> _playerFilter;
-    std::shared_ptr<ecs::Filter> _scoreFilter;
+    std::shared_ptr<ecs::Pool<CPlayerTag>> _playerTagPool;
 
-    std::shared_ptr<ecs::Pool<CCollisionHit>> _hitPool;
-
-    std::shared_ptr<ecs::Pool<CFragmentTag>> _fragmentTagPool;
-    std::shared_ptr<ecs::Pool<CLifespan>> _lifespanPool;
-    std::shared_ptr<ecs::Pool<CShape>> _shapePool;
-    std::shared_ptr<ecs::Pool<CDrawable>> _drawablePool;
-    std::shared_ptr<ecs::Pool<CTransform>> _transformPool;
+    std::shared_ptr<const ecs::Pool<CTransform>> _transformPool;
     std::shared_ptr<ecs::Pool<CVelocity>> _velocityPool;
-    std::shared_ptr<ecs::Pool<CRotationVelocity>> _rotationVelocityPool;
     std::shared_ptr<ecs::Pool<CCollider>> _colliderPool;
 
-    std::shared_ptr<ecs::Pool<CScore>> _scorePool;
+    std::shared_ptr<CScore> _score;
+
+    std::vector<ecs::Entity> _destroyed;
 
 public:
-    explicit DestroyPlayerSystem(const Config& config)
+    DestroyPlayerSystem(const Config& config, const Geometries& geometries, const physics::Contacts& contacts,
+                        particles::ParticlePool& fragments)
     : _config(config)
+    , _geometries(geometries)
+    , _contacts(contacts)
+    , _fragments(fragments)
     {
     }
 
     [[nodiscard]] const std::string& name() const override { return _name; }
 
     void init(ecs::World &world) override {
-        _hitPool = world.pool<CCollisionHit>();
+        _playerTagPool = world.pool<CPlayerTag>();
 
         _colliderPool = world.pool<CCollider>();
-        _fragmentTagPool = world.pool<CFragmentTag>();
-        _lifespanPool = world.pool<CLifespan>();
-        _shapePool = world.pool<CShape>();
-        _drawablePool = world.pool<CDrawable>();
         _transformPool = world.pool<CTransform>();
         _velocityPool = world.pool<CVelocity>();
-        _rotationVelocityPool = world.pool<CRotationVelocity>();
-
-        _scorePool = world.pool<CScore>();
-
-        _playerFilter = world.buildFilter()
-                .include<CPlayerTag>()
-                .include<CCollisionHit>()
-                .build();
 
-        _scoreFilter = world.buildFilter()
-                .include<CScore>()
-                .build();
+        _score = world.resource<CScore>();
     }
 
     void run(ecs::World &world, const sf::Time& dt) override {
-        for (const auto &entity: _playerFilter->entities()) {
-            spawnFragment(world, entity);
-            updateScore();
-            world.deleteEntity(entity);
+        _destroyed.clear();
+        for (const auto &contact: _contacts) {
+            onContact(world, contact, contact.a);
+            onContact(world, contact, contact.b);
         }
     }
 
-    void updateScore() {
-        for (const auto &scoreEntity: _scoreFilter->entities()) {
-            auto &score = _scorePool->get(scoreEntity);
+    void onContact(ecs::World &world, const physics::Contact &contact, const ecs::Entity &playerEntity) {
+        if (!_playerTagPool->has(playerEntity)) return;
+        if (std::find(_destroyed.begin(), _destroyed.end(), playerEntity) != _destroyed.end()) return;
 
-            score.value = 0;
-        }
+        spawnFragment(playerEntity, contact.other(playerEntity));
+        updateScore();
+        world.deleteEntity(playerEntity);
+        _destroyed.push_back(playerEntity);
     }
 
-    void spawnFragment(ecs::World &world, const ecs::Entity &asteroidEntity) {
-        const auto &hit = _hitPool->get(asteroidEntity);
-        const auto &transform = _transformPool->get(asteroidEntity);
-        const auto &collider = _colliderPool->get(asteroidEntity);
+    void updateScore() {
+        _score->value = 0;
+    }
+
+    void spawnFragment(const ecs::Entity &playerEntity, const ecs::Entity &otherEntity) {
+        const auto otherVelocity = std::as_const(*_velocityPool).get(otherEntity);
+        // copies, the fragments go into the same pools
+        const auto transform = std::as_const(*_transformPool).get(playerEntity);
+        const auto collider = std::as_const(*_colliderPool).get(playerEntity);
 
-        auto otherVelocityNormalized = hit.velocity.normalized();
+        auto otherVelocityNormalized = otherVelocity.value.normalized();
         auto angleStep = 360 / 8;
         for (int i = 0; i < 8; ++i) {
-            auto entity = world.newEntity();
-
             auto forward = otherVelocityNormalized.rotate(float(i * angleStep));
             auto position = transform.position + forward * collider.value;
-            auto shape = createShape(position);
-
-            _fragmentTagPool->add(entity);
-            _shapePool->add(entity, { shape });
-            _drawablePool->add(entity, { shape });
-            _transformPool->add(entity, CTransform(position));
-            _lifespanPool->add(entity, {_config.projectile.lifespan });
-            _velocityPool->add(entity, {forward * _config.fragment.speed });
-            _rotationVelocityPool->add(entity, {_config.fragment.rotationSpeed});
-        }
-    }
 
-    std::shared_ptr<sf::CircleShape> createShape(Vector2 position) {
-        auto shape = std::make_shared<sf::CircleShape>(3, 3);
-        shape->setPosition(position());
-        shape->setFillColor(_config.fragment.fillColor());
-        shape->setOutlineColor(_config.fragment.outlineColor());
-        shape->setOutlineThickness(_config.fragment.outlineThickness);
-        shape->setOrigin(0.5f, 0.5f);
-        return shape;
+            _fragments.emit(position, forward * _config.fragment.speed, _config.fragment.rotationSpeed,
+                            _config.fragment.radius, _geometries.fragment(3), uint32_t(_config.fragment.lifespan));
+        }
     }
 };
 
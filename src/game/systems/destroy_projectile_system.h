@@ -10,26 +10,32 @@
 #include "../../ecs/systems.h"
 #include "../components/components.h"
 #include "../config/config.h"
+#include "../../physics/contact.h"
 
 class DestroyProjectileSystem : public ecs::IInitSystem, public ecs::IRunSystem {
 private:
     const std::string _name = "DestroyProjectileSystem";
 
-    std::shared_ptr<ecs::Filter> _filter;
+    const physics::Contacts& _contacts;
+
+    std::shared_ptr<ecs::Pool<CProjectileTag>> _projectileTagPool;
 
 public:
+    explicit DestroyProjectileSystem(const physics::Contacts& contacts)
+    : _contacts(contacts)
+    {
+    }
+
     [[nodiscard]] const std::string& name() const override { return _name; }
 
     void init(ecs::World &world) override {
-        _filter = world.buildFilter()
-                .include<CProjectileTag>()
-                .include<CCollisionHit>()
-                .build();
+        _projectileTagPool = world.pool<CProjectileTag>();
     }
 
     void run(ecs::World &world, const sf::Time& dt) override {
-        for (const auto &entity: _filter->entities()) {
-            world.deleteEntity(entity);
+        for (const auto &contact: _contacts) {
+            if (_projectileTagPool->has(contact.a)) world.deleteEntity(contact.a);
+            if (_projectileTagPool->has(contact.b)) world.deleteEntity(contact.b);
         }
     }
 };
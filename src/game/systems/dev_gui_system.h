@@ -15,6 +15,8 @@
 #include "../../ecs/systems.h"
 #include "../../utils/utils.h"
 
+#include "../../particles/particle_pool.h"
+
 #include "../config/config.h"
 
 class DevGuiSystem :
@@ -29,15 +31,14 @@ private:
     std::shared_ptr<ecs::Pool<CPlayerTag>> _playerTagPool;
     std::shared_ptr<ecs::Pool<CAsteroidTag>> _asteroidTagPool;
     std::shared_ptr<ecs::Pool<CProjectileTag>> _projectileTagPool;
-    std::shared_ptr<ecs::Pool<CFragmentTag>> _fragmentTagPool;
 
     std::shared_ptr<ecs::Filter> _asteroidsFilter;
     std::shared_ptr<ecs::Filter> _projectileFilter;
-    std::shared_ptr<ecs::Filter> _fragmentFilter;
     std::shared_ptr<ecs::Filter> _playerFilter;
 
     sf::RenderWindow &_window;
     ecs::Systems &_systems;
+    const particles::ParticlePool &_fragments;
 
     bool _initialized = false;
 
@@ -78,12 +79,10 @@ private:
                 }
                 ImGui::TreePop();
             }
-            if (ImGui::TreeNode("Fragment:")) {
-                for (auto &entity: _fragmentFilter->entities()) {
-                    renderEntity(world, entity);
-                }
-                ImGui::TreePop();
-            }
+            // fragments are particles, not entities
+            ImGui::Text("Fragments: %zu / %zu", _fragments.size(), _fragments.capacity());
+            ImGui::Text("World allocations: %zu", ecs::World::allocations());
+            ImGui::Text("Filters: %zu", world.filterCount());
         }
     }
 
@@ -95,30 +94,28 @@ private:
             col32.SetHSV(0.3f, 0.7f, 0.7f);
         } else if (_projectileTagPool->has(entity)) {
             col32.SetHSV(0.5f, 0.7f, 0.7f);
-        } else if (_fragmentTagPool->has(entity)) {
-            col32.SetHSV(0.7f, 0.7f, 0.7f);
         }
 
         const float sz = 10.0f;
         const ImVec2 p = ImGui::GetCursorScreenPos();
         ImDrawList* draw_list = ImGui::GetWindowDrawList();
         draw_list->AddRectFilled(ImVec2(p.x, p.y), ImVec2(p.x+sz, p.y+sz), col32, 3.0f);
-        ImGui::Text("  Entity %d", entity);
+        ImGui::Text("  Entity %u:%u", ecs::entityIndex(entity), ecs::entityGeneration(entity));
     }
 
 public:
-    DevGuiSystem(sf::RenderWindow &window, ecs::Systems &systems)
-            : _window(window), _systems(systems) {}
+    DevGuiSystem(sf::RenderWindow &window, ecs::Systems &systems, const particles::ParticlePool &fragments)
+            : _window(window), _systems(systems), _fragments(fragments) {}
 
     [[nodiscard]] const std::string &name() const override { return _name; }
 
     void init(ecs::World &world) override {
-        _initialized = ImGui::SFML::Init(_window, true);
+        // headless runs never open the window
+        _initialized = _window.isOpen() && ImGui::SFML::Init(_window, true);
 
         _playerTagPool = world.pool<CPlayerTag>();
         _asteroidTagPool = world.pool<CAsteroidTag>();
         _projectileTagPool = world.pool<CProjectileTag>();
-        _fragmentTagPool = world.pool<CFragmentTag>();
 
         _asteroidsFilter = world.buildFilter()
                 .include<CAsteroidTag>()
@@ -129,9 +126,6 @@ public:
         _projectileFilter = world.buildFilter()
                 .include<CProjectileTag>()
                 .build();
-        _fragmentFilter = world.buildFilter()
-                .include<CFragmentTag>()
-                .build();
     }
 
     void event(ecs::World &world, const sf::Event &event) override {
@@ -8,39 +8,160 @@
 #include <SFML/Graphics.hpp>
 #include <memory>
 #include "../../ecs/systems.h"
+#include "../../particles/particle_pool.h"
+#include "../../physics/spatial_index.h"
+#include "../../render/backend.h"
+#include "../../render/geometry_library.h"
+#include "../../render/lod_policy.h"
+#include "../../render/resource_pool.h"
+#include "../camera.h"
 
 class DrawSystem : public ecs::IInitSystem, public ecs::IRenderSystem {
 private:
     const std::string _name = "DrawSystem";
+    // covers outlines sticking out of the colliders
+    static constexpr float CULL_MARGIN = 8.f;
 
     sf::RenderWindow& _window;
+    render::IBackend& _backend;
+    const render::GeometryLibrary& _geometries;
+    const render::LodPolicy& _lod;
+    const physics::SpatialIndex& _spatialIndex;
+    const particles::ParticlePool& _fragments;
+    const Camera& _camera;
+    const render::ResourcePool<sf::Text>& _texts;
 
+    render::CommandList _commands;
+    std::vector<ecs::Entity> _visible;
+
+    std::shared_ptr<ecs::Filter> _unindexedFilter;
     std::shared_ptr<ecs::Filter> _filter;
-    std::shared_ptr<ecs::Pool<CDrawable>> _drawablePool;
+    std::shared_ptr<const ecs::Pool<CTransform>> _transformPool;
+    std::shared_ptr<ecs::Pool<CGeometry>> _geometryPool;
+    std::shared_ptr<ecs::Pool<CRenderLayer>> _renderLayerPool;
+    std::shared_ptr<const ecs::Pool<CText>> _textPool;
 
 public:
-    explicit DrawSystem(sf::RenderWindow& window)
+    DrawSystem(sf::RenderWindow& window, render::IBackend& backend, const render::GeometryLibrary& geometries,
+               const render::LodPolicy& lod, const physics::SpatialIndex& spatialIndex,
+               const particles::ParticlePool& fragments, const Camera& camera,
+               const render::ResourcePool<sf::Text>& texts)
     : _window(window)
+    , _backend(backend)
+    , _geometries(geometries)
+    , _lod(lod)
+    , _spatialIndex(spatialIndex)
+    , _fragments(fragments)
+    , _camera(camera)
+    , _texts(texts)
     {
     }
 
     [[nodiscard]] const std::string& name() const override { return _name; }
 
     void init(ecs::World& world) override {
-        _drawablePool = world.pool<CDrawable>();
+        _transformPool = world.pool<CTransform>();
+        _geometryPool = world.pool<CGeometry>();
+        _textPool = world.pool<CText>();
+        _renderLayerPool = world.pool<CRenderLayer>();
+
+        // geometries go to the render backend sorted by layer, the HUD texts are
+        // drawn to the window on top of every layer, the dev GUI comes after them.
+        // Colliders are looked up in the spatial index, the few geometries without a collider and
+        // the particles are tested one by one.
+        _unindexedFilter = world.buildFilter()
+                .include<CTransform>()
+                .include<CGeometry>()
+                .exclude<CCollider>()
+                .build();
         _filter = world.buildFilter()
-                .include<CDrawable>()
+                .include<CText>()
                 .build();
     }
 
     void render(ecs::World& world) override {
+        _commands.clear(_camera.center(), _camera.size());
+
+        auto margin = Vector2(CULL_MARGIN, CULL_MARGIN);
+        _spatialIndex.queryAabb(_camera.min() - margin, _camera.max() + margin, _visible);
+        for (const auto & entity : _visible) {
+            // the index was built before this tick's destruction
+            if (!world.isEnabled(entity) || !_geometryPool->has(entity) || !_transformPool->has(entity)) continue;
+            add(entity);
+        }
+
+        for (const auto & entity : _unindexedFilter->entities()) {
+            const auto & transform = _transformPool->get(entity);
+            if (_camera.isVisible(transform.position, transform.scale + CULL_MARGIN)) {
+                add(entity);
+            }
+        }
+
+        addParticles(_fragments, CRenderLayer::FRAGMENTS);
+
+        _commands.sort();
+        _backend.submit(_commands);
+
+        // headless runs have no window to draw the HUD to
+        if (!_window.isOpen()) return;
+
         for (const auto & entity : _filter->entities()) {
-            const auto & drawable = _drawablePool->get(entity);
-            if (drawable.value) {
-                _window.draw(*(drawable.value));
+            const auto & text = _textPool->get(entity);
+            if (_texts.contains(text.value)) {
+                _window.draw(_texts.get(text.value));
             }
         }
     }
+
+private:
+    void addParticles(const particles::ParticlePool& pool, uint8_t layer) {
+        for (size_t i = 0; i < pool.size(); ++i) {
+            auto scale = pool.scale(i);
+            auto position = pool.position(i);
+            if (!_camera.isVisible(position, scale + CULL_MARGIN)) continue;
+
+            _commands.add({
+                    pool.geometry(i),
+                    _camera.nearestImage(position)(),
+                    pool.rotation(i),
+                    scale,
+                    pool.fillColor(i),
+                    pool.outlineColor(i),
+                    scale != 0 ? pool.outlineThickness() / scale : 0,
+                    layer,
+                    render::Blend::Alpha
+            });
+        }
+    }
+
+    void add(const ecs::Entity& entity) {
+        const auto & transform = _transformPool->get(entity);
+        const auto & geometry = _geometryPool->get(entity);
+
+        // geometries have a radius of 1, the outline keeps its thickness in pixels
+        auto outlineThickness = transform.scale != 0 ? geometry.outlineThickness / transform.scale : 0;
+
+        // only geometries with a simplified version have levels of detail, the camera shows the world 1:1
+        auto id = geometry.id;
+        auto simplified = _geometries.simplified(id);
+        if (simplified != id) {
+            auto lod = _lod.level(transform.scale);
+            if (lod != render::Lod::Full) id = simplified;
+            if (lod == render::Lod::Fill) outlineThickness = 0;
+        }
+
+        _commands.add({
+                id,
+                _camera.nearestImage(transform.position)(),
+                transform.rotation,
+                transform.scale,
+                geometry.fillColor,
+                geometry.outlineColor,
+                outlineThickness,
+                _renderLayerPool->has(entity) ? _renderLayerPool->get(entity).value : uint8_t(0),
+                render::Blend::Alpha
+        });
+    }
 };
 
 #endif //ECS_DRAW_SYSTEM_H
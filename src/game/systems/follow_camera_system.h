@@ -0,0 +1,48 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef ECS_FOLLOW_CAMERA_SYSTEM_H
+#define ECS_FOLLOW_CAMERA_SYSTEM_H
+
+#include "../components/components.h"
+
+#include "../../ecs/systems.h"
+
+#include "../camera.h"
+
+class FollowCameraSystem : public ecs::IInitSystem, public ecs::IRunSystem {
+private:
+    const std::string _name = "FollowCameraSystem";
+
+    Camera& _camera;
+
+    std::shared_ptr<ecs::Filter> _filter = nullptr;
+    std::shared_ptr<const ecs::Pool<CTransform>> _transformPool = nullptr;
+
+public:
+    explicit FollowCameraSystem(Camera& camera)
+    : _camera(camera)
+    {
+    }
+
+    [[nodiscard]] const std::string& name() const override { return _name; }
+
+    void init(ecs::World& world) override {
+        _transformPool = world.pool<CTransform>();
+
+        _filter = world.buildFilter()
+                .include<CPlayerTag>()
+                .include<CTransform>()
+                .build();
+    }
+
+    void run(ecs::World& world, const sf::Time& dt) override {
+        // the camera stays where the player died until the next one spawns
+        for (auto entity : _filter->entities()) {
+            _camera.center = _transformPool->get(entity).position;
+        }
+    }
+};
+
+#endif //ECS_FOLLOW_CAMERA_SYSTEM_H
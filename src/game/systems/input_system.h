@@ -37,7 +37,7 @@ public:
 
     void updateInput(const sf::Event &event, bool value) {
         for (auto entity: _filter->entities()) {
-            auto &input = _inputPool->get(entity);
+            auto &input = _inputPool->write(entity);
 
             switch (event.key.code) {
                 case sf::Keyboard::A:
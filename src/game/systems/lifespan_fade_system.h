@@ -18,36 +18,33 @@ private:
     std::shared_ptr<ecs::Filter> _filter = nullptr;
 
     std::shared_ptr<ecs::Pool<CLifespan>> _lifespanPool = nullptr;
-    std::shared_ptr<ecs::Pool<CShape>> _shapePool = nullptr;
+    std::shared_ptr<ecs::Pool<CGeometry>> _geometryPool = nullptr;
 public:
 
     [[nodiscard]] const std::string& name() const override { return _name; }
 
     void init(ecs::World& world) override {
         _lifespanPool = world.pool<CLifespan>();
-        _shapePool = world.pool<CShape>();
+        _geometryPool = world.pool<CGeometry>();
 
         _filter = world.buildFilter()
                 .include<CLifespan>()
-                .include<CShape>()
+                .include<CGeometry>()
                 .build();
     }
 
     void run(ecs::World& world, const sf::Time& dt) override {
         for (const auto & entity : _filter->entities()) {
-            auto & shape = _shapePool->get(entity);
-            auto & lifespan = _lifespanPool->get(entity);
+            auto & geometry = _geometryPool->write(entity);
+            const auto & lifespan = _lifespanPool->get(entity);
 
             auto tick = sf::Uint8(255 / lifespan.total);
 
-            auto fillColor = shape.value->getFillColor();
-            auto outerColor = shape.value->getOutlineColor();
+            auto & fillColor = geometry.fillColor;
+            auto & outerColor = geometry.outlineColor;
 
             fillColor.a = std::clamp(fillColor.a - tick, 0, 255);
             outerColor.a = std::clamp(fillColor.a - tick, 0, 255);
-
-            shape.value->setFillColor(fillColor);
-            shape.value->setOutlineColor(outerColor);
         }
     }
 };
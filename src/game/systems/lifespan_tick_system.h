@@ -31,7 +31,7 @@ public:
 
     void run(ecs::World& world, const sf::Time& dt) override {
         for (const auto & entity : _filter->entities()) {
-            auto & lifespan = _lifespanPool->get(entity);
+            auto & lifespan = _lifespanPool->write(entity);
 
             // todo: replace with delta time
             lifespan.current -= 1;
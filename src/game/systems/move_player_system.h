@@ -18,7 +18,7 @@ private:
 
     std::shared_ptr<ecs::Filter> _filter = nullptr;
 
-    std::shared_ptr<ecs::Pool<CTransform>> _transformPool = nullptr;
+    std::shared_ptr<const ecs::Pool<CTransform>> _transformPool = nullptr;
     std::shared_ptr<ecs::Pool<CInput>> _inputPool = nullptr;
     std::shared_ptr<ecs::Pool<CMoveSpeed>> _speedPool = nullptr;
     std::shared_ptr<ecs::Pool<CMoveAcceleration>> _accelerationPool = nullptr;
@@ -46,7 +46,7 @@ public:
 
     void run(ecs::World& world, const sf::Time& dt) override {
         for (auto entity : _filter->entities()) {
-            auto & velocity = _velocityPool->get(entity);
+            auto velocity = _velocityPool->write(entity);
 
             const auto & transform = _transformPool->get(entity);
             const auto & speed= _speedPool->get(entity);
@@ -8,6 +8,7 @@
 #include <SFML/Graphics.hpp>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "../components/components.h"
 
@@ -27,6 +28,10 @@ private:
     std::shared_ptr<ecs::Pool<CTransform>> _transformPool = nullptr;
     std::shared_ptr<ecs::Pool<CVelocity>> _velocityPool = nullptr;
 
+    // positions of the filtered entities in the columns of the pools, gathered every run
+    std::vector<uint32_t> _transformIndices;
+    std::vector<uint32_t> _velocityIndices;
+
 public:
     [[nodiscard]] const std::string& name() const override { return _name; }
 
@@ -41,12 +46,27 @@ public:
     }
 
     void run(ecs::World& world, const sf::Time& dt) override {
+        typedef ecs::SoaLayout<CTransform> Transform;
+        typedef ecs::SoaLayout<CVelocity> Velocity;
+
+        _transformIndices.clear();
+        _velocityIndices.clear();
         for (auto entity : _filter->entities()) {
-            auto & transform = _transformPool->get(entity);
+            _transformIndices.push_back(_transformPool->index(entity));
+            _velocityIndices.push_back(_velocityPool->index(entity));
+        }
+        _transformPool->markChanged(_transformIndices);
 
-            const auto & velocity = _velocityPool->get(entity);
+        auto x = _transformPool->column(Transform::X);
+        auto y = _transformPool->column(Transform::Y);
+        const auto vx = std::as_const(*_velocityPool).column(Velocity::X);
+        const auto vy = std::as_const(*_velocityPool).column(Velocity::Y);
+        const auto t = _transformIndices.data();
+        const auto v = _velocityIndices.data();
 
-            transform.position += velocity.value;
+        for (size_t i = 0, count = _transformIndices.size(); i < count; ++i) {
+            x[t[i]] += vx[v[i]];
+            y[t[i]] += vy[v[i]];
         }
     }
 };
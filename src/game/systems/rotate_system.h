@@ -5,6 +5,9 @@
 #ifndef ECS_ROTATE_SYSTEM_H
 #define ECS_ROTATE_SYSTEM_H
 
+#include <utility>
+#include <vector>
+
 #include "../components/components.h"
 
 #include "../../data/color.h"
@@ -20,6 +23,10 @@ private:
     std::shared_ptr<ecs::Pool<CTransform>> _transformPool = nullptr;
     std::shared_ptr<ecs::Pool<CRotationVelocity>> _rotationVelocityPool = nullptr;
 
+    // positions of the filtered entities in the columns of the pools, gathered every run
+    std::vector<uint32_t> _transformIndices;
+    std::vector<uint32_t> _rotationVelocityIndices;
+
 public:
     [[nodiscard]] const std::string& name() const override { return _name; }
 
@@ -34,14 +41,27 @@ public:
     }
 
     void run(ecs::World& world, const sf::Time& dt) override {
+        typedef ecs::SoaLayout<CTransform> Transform;
+        typedef ecs::SoaLayout<CRotationVelocity> RotationVelocity;
+
+        _transformIndices.clear();
+        _rotationVelocityIndices.clear();
         for (auto entity : _filter->entities()) {
-            auto & transform = _transformPool->get(entity);
-            const auto & _rotationVelocity = _rotationVelocityPool->get(entity);
+            _transformIndices.push_back(_transformPool->index(entity));
+            _rotationVelocityIndices.push_back(_rotationVelocityPool->index(entity));
+        }
+        _transformPool->markChanged(_transformIndices);
 
-            transform.rotation += _rotationVelocity.value;
+        auto rotation = _transformPool->column(Transform::ROTATION);
+        const auto velocity = std::as_const(*_rotationVelocityPool).column(RotationVelocity::VALUE);
+        const auto t = _transformIndices.data();
+        const auto r = _rotationVelocityIndices.data();
 
-            if (transform.rotation > 360) { transform.rotation -= 360; }
-            if (transform.rotation < 0) { transform.rotation += 360; }
+        for (size_t i = 0, count = _transformIndices.size(); i < count; ++i) {
+            auto angle = rotation[t[i]] + velocity[r[i]];
+            angle -= angle > 360 ? 360.f : 0.f;
+            angle += angle < 0 ? 360.f : 0.f;
+            rotation[t[i]] = angle;
         }
     }
 };
@@ -5,11 +5,14 @@
 #ifndef ECS_SCORE_SYSTEM_H
 #define ECS_SCORE_SYSTEM_H
 
+#include <optional>
+
 #include "../components/components.h"
 
 #include "../../data/color.h"
 #include "../../data/vector2.h"
 #include "../../ecs/systems.h"
+#include "../../render/resource_pool.h"
 #include "../../utils/utils.h"
 
 #include "../config/config.h"
@@ -19,16 +22,18 @@ private:
     const std::string _name = "ScoreSystem";
 
     const Config& _config;
-
-    std::shared_ptr<ecs::Filter> _filter = nullptr;
+    render::ResourcePool<sf::Text>& _texts;
 
     std::shared_ptr<ecs::Pool<CText>> _textPool = nullptr;
-    std::shared_ptr<ecs::Pool<CScore>> _scorePool = nullptr;
-    std::shared_ptr<ecs::Pool<CDrawable>> _drawablePool = nullptr;
+    std::shared_ptr<const CScore> _score = nullptr;
+
+    ecs::Entity _textEntity = 0;
+    std::optional<uint> _shownScore;
 
 public:
-    explicit ScoreSystem(const Config & config)
+    ScoreSystem(const Config & config, render::ResourcePool<sf::Text>& texts)
     : _config(config)
+    , _texts(texts)
     {
     }
 
@@ -36,40 +41,38 @@ public:
 
     void init(ecs::World &world) override {
         _textPool = world.pool<CText>();
-        _scorePool = world.pool<CScore>();
-        _drawablePool = world.pool<CDrawable>();
-
-        auto entity= world.newEntity();
-        auto text = createText();
+        _score = world.resource<CScore>();
 
-        _textPool->add(entity, { text });
-        _drawablePool->add(entity, { text });
-        _scorePool->add(entity);
+        _textEntity = world.newEntity();
+        _textPool->add(_textEntity, { createText() });
 
-        _filter = world.buildFilter()
-                .include<CText>()
-                .include<CScore>()
-                .build();
+        // the texts live in the pool until their entities go away
+        world.onRemove<CText>([this](const ecs::Entities& entities) {
+            for (const auto& entity : entities) {
+                _texts.release(std::as_const(*_textPool).get(entity).value);
+            }
+        });
     }
 
     void run(ecs::World &world, const sf::Time& dt) override {
-        for (auto entity: _filter->entities()) {
-            const auto & score = _scorePool->get(entity);
-            auto & text = _textPool->get(entity);
+        // laying out the text is not free, the score changes a few times a minute
+        if (_shownScore == _score->value) return;
+        _shownScore = _score->value;
 
-            text.value->setString("Score: " +  std::to_string(score.value));
-        }
+        const auto & text = std::as_const(*_textPool).get(_textEntity);
+        _texts.get(text.value).setString("Score: " +  std::to_string(_score->value));
     }
 
-    std::shared_ptr<sf::Text> createText() {
-        auto text = std::make_shared<sf::Text>();
+    render::ResourceHandle createText() {
+        auto handle = _texts.create();
+        auto & text = _texts.get(handle);
 
-        text->setPosition(20, 20);
-        text->setFont(*_config.font.font);
-        text->setCharacterSize(_config.font.size);
-        text->setFillColor(_config.font.color());
+        text.setPosition(20, 20);
+        text.setFont(*_config.font.font);
+        text.setCharacterSize(_config.font.size);
+        text.setFillColor(_config.font.color());
 
-        return text;
+        return handle;
     }
 };
 
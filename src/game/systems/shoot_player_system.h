@@ -11,16 +11,20 @@
 
 #include "../../data/color.h"
 #include "../../data/vector2.h"
+#include "../../ecs/prefab.h"
 #include "../../ecs/systems.h"
 #include "../../utils/utils.h"
 
 #include "../config/config.h"
+#include "../geometries.h"
 
 class ShootPlayerSystem : public ecs::IInitSystem, public ecs::IRunSystem {
 private:
     const std::string _name = "ShootPlayerSystem";
 
     const Config& _config;
+    const Geometries& _geometries;
+    const ecs::Prefab& _prefab;
 
     std::shared_ptr<ecs::Filter> _filter = nullptr;
 
@@ -28,16 +32,16 @@ private:
     std::shared_ptr<ecs::Pool<CInput>> _inputPool;
     std::shared_ptr<ecs::Pool<CCooldown>> _cooldownPool;
 
-    std::shared_ptr<ecs::Pool<CProjectileTag>> _projectileTagPool;
     std::shared_ptr<ecs::Pool<CVelocity>> _velocityPool;
-    std::shared_ptr<ecs::Pool<CShape>> _shapePool;
-    std::shared_ptr<ecs::Pool<CDrawable>> _drawablePool;
+    std::shared_ptr<ecs::Pool<CGeometry>> _geometryPool;
     std::shared_ptr<ecs::Pool<CLifespan>> _lifespanPool;
     std::shared_ptr<ecs::Pool<CCollider>> _colliderPool;
 
 public:
-    explicit ShootPlayerSystem(const Config& config)
+    ShootPlayerSystem(const Config& config, const Geometries& geometries, const ecs::Prefab& prefab)
     : _config(config)
+    , _geometries(geometries)
+    , _prefab(prefab)
     {
     }
 
@@ -48,10 +52,8 @@ public:
         _inputPool = world.pool<CInput>();
         _cooldownPool = world.pool<CCooldown>();
 
-        _projectileTagPool = world.pool<CProjectileTag>();
         _velocityPool = world.pool<CVelocity>();
-        _shapePool = world.pool<CShape>();
-        _drawablePool = world.pool<CDrawable>();
+        _geometryPool = world.pool<CGeometry>();
         _lifespanPool = world.pool<CLifespan>();
         _colliderPool = world.pool<CCollider>();
 
@@ -66,7 +68,7 @@ public:
     void run(ecs::World& world, const sf::Time& dt) override {
         for (auto entity : _filter->entities()) {
             const auto & input = _inputPool->get(entity);
-            const auto & transform = _transformPool->get(entity);
+            const auto & transform = std::as_const(*_transformPool).get(entity);
 
             if (input.shoot) {
                 spawnProjectile(world, transform.position, transform.forward());
@@ -77,24 +79,13 @@ public:
     }
 
     void spawnProjectile(ecs::World& world, Vector2 position, Vector2 forward) {
-        auto entity = world.newEntity();
-        auto shape = createShape(position);
-
-        _projectileTagPool->add(entity);
-        _transformPool->add(entity, CTransform(position + forward * _config.player.radius));
-        _shapePool->add(entity, {shape });
-        _drawablePool->add(entity, {shape });
-        _velocityPool->add(entity, { forward * _config.projectile.speed });
-        _colliderPool->add(entity, { _config.projectile.radius });
-        _lifespanPool->add(entity, {_config.projectile.lifespan });
-    }
-
-    std::shared_ptr<sf::CircleShape> createShape(Vector2 position) {
-        auto shape = std::make_shared<sf::CircleShape>(_config.projectile.radius, 5);
-        shape->setFillColor(_config.projectile.fillColor());
-        shape->setOrigin(0.5f, 0.5f);
-        shape->setPosition(position());
-        return shape;
+        world.instantiate(_prefab, 1, [&](const ecs::Entity& entity, size_t) {
+            _transformPool->write(entity) = CTransform(position + forward * _config.player.radius, 0, _config.projectile.radius);
+            _geometryPool->write(entity) = { _geometries.projectile, _config.projectile.fillColor(), sf::Color::Transparent };
+            _velocityPool->write(entity) = CVelocity(forward * _config.projectile.speed);
+            _colliderPool->write(entity) = { _config.projectile.radius };
+            _lifespanPool->write(entity) = { _config.projectile.lifespan };
+        });
     }
 };
 
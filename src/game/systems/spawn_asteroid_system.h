@@ -9,15 +9,30 @@
 
 #include "../../data/color.h"
 #include "../../data/vector2.h"
+#include "../../ecs/prefab.h"
 #include "../../ecs/systems.h"
+#include "../../physics/spatial_index.h"
 #include "../../utils/utils.h"
 
+#include "../camera.h"
 #include "../config/config.h"
+#include "../geometries.h"
 
 class SpawnAsteroidSystem : public ecs::IInitSystem, public ecs::IRunSystem {
 private:
     const std::string _name = "SpawnAsteroidSystem";
+    // random positions tried before giving up on keeping the distance to the player
+    static constexpr int SPAWN_ATTEMPTS = 8;
+    // radius added to the base radius by the heaviest asteroid
+    static constexpr float MASS_RADIUS = 20.f;
+
     const Config& _config;
+    const Geometries& _geometries;
+    const physics::SpatialIndex& _spatialIndex;
+    const Camera& _camera;
+    const ecs::Prefab& _prefab;
+
+    std::vector<ecs::Entity> _nearby;
 
     std::shared_ptr<ecs::Filter> _spawnFilter = nullptr;
     std::shared_ptr<ecs::Filter> _asteroidFilter = nullptr;
@@ -26,17 +41,21 @@ private:
     std::shared_ptr<ecs::Pool<CCooldown>> _cooldownPool = nullptr;
 
     std::shared_ptr<ecs::Pool<CRotationVelocity>> _rotationVelocityPool = nullptr;
-    std::shared_ptr<ecs::Pool<CAsteroidTag>> _asteroidTagPool = nullptr;
+    std::shared_ptr<ecs::Pool<CPlayerTag>> _playerTagPool = nullptr;
     std::shared_ptr<ecs::Pool<CTransform>> _transformPool = nullptr;
     std::shared_ptr<ecs::Pool<CVelocity>> _velocityPool = nullptr;
     std::shared_ptr<ecs::Pool<CCollider>> _colliderPool = nullptr;
-    std::shared_ptr<ecs::Pool<CShape>> _shapePool = nullptr;
-    std::shared_ptr<ecs::Pool<CDrawable>> _drawablePool = nullptr;
+    std::shared_ptr<ecs::Pool<CGeometry>> _geometryPool = nullptr;
     std::shared_ptr<ecs::Pool<CMass>> _massPool = nullptr;
 
 public:
-    explicit SpawnAsteroidSystem(const Config& config)
+    SpawnAsteroidSystem(const Config& config, const Geometries& geometries, const physics::SpatialIndex& spatialIndex,
+                        const Camera& camera, const ecs::Prefab& prefab)
     : _config(config)
+    , _geometries(geometries)
+    , _spatialIndex(spatialIndex)
+    , _camera(camera)
+    , _prefab(prefab)
     {
     }
 
@@ -46,13 +65,12 @@ public:
         _asteroidSpawnerTagPool = world.pool<CAsteroidSpawnerTag>();
         _cooldownPool = world.pool<CCooldown>();
 
-        _asteroidTagPool = world.pool<CAsteroidTag>();
+        _playerTagPool = world.pool<CPlayerTag>();
         _rotationVelocityPool = world.pool<CRotationVelocity>();
         _transformPool = world.pool<CTransform>();
         _velocityPool = world.pool<CVelocity>();
         _colliderPool = world.pool<CCollider>();
-        _shapePool = world.pool<CShape>();
-        _drawablePool = world.pool<CDrawable>();
+        _geometryPool = world.pool<CGeometry>();
         _massPool = world.pool<CMass>();
 
         _asteroidFilter = world.buildFilter()
@@ -79,84 +97,77 @@ public:
     }
 
     void createNewObstacle(ecs::World& world) {
-        auto entity = world.newEntity();
-
         auto fMass = random(_config.asteroid.massMin, _config.asteroid.massMax);
         auto mass = uint(fMass);
         auto diff = (fMass - _config.asteroid.massMin) / (_config.asteroid.massMax - _config.asteroid.massMin);
         auto rotation = random(_config.asteroid.rotationSpeedMin, _config.asteroid.rotationSpeedMax);
 
-        auto radius = _config.asteroid.baseRadius + 20.f * diff;
+        auto radius = _config.asteroid.baseRadius + MASS_RADIUS * diff;
         auto speed = _config.asteroid.baseSpeed - 1.2f * diff;
 
-        auto position = createPosition();
+        auto position = createSafePosition();
         auto velocity = createVelocity(position) * speed;
-        auto shape = createShape(radius, mass, position);
-
-        _asteroidTagPool->add(entity);
-        _transformPool->add(entity, CTransform(position));
-        _shapePool->add(entity, { shape });
-        _drawablePool->add(entity, { shape });
-        _velocityPool->add(entity, { velocity  });
-        _colliderPool->add(entity, { radius });
-        _rotationVelocityPool->add(entity, { rotation });
-        _massPool->add(entity, { mass });
-    }
 
-    Vector2 createVelocity(const Vector2& position) {
-        return (Vector2T(
-                random(0.2f * float(_config.window.width), 0.8f * float(_config.window.width)),
-                random(0.2f * float(_config.window.height), 0.8f * float(_config.window.height))
-        ) - position).normalized();
+        world.instantiate(_prefab, 1, [&](const ecs::Entity& entity, size_t) {
+            _transformPool->write(entity) = CTransform(position, 0, radius);
+            _geometryPool->write(entity) = createGeometry(mass);
+            _velocityPool->write(entity) = CVelocity(velocity);
+            _colliderPool->write(entity) = { radius };
+            _rotationVelocityPool->write(entity) = CRotationVelocity { rotation };
+            _massPool->write(entity) = { mass };
+        });
     }
 
-    Vector2 createPosition() {
-        auto screen = Vector2(float(_config.window.width), float(_config.window.width));
-        auto center = screen * 0.5f;
-        auto position = Vector2T(
-                random(0.01f * float(_config.window.width), 0.99f * float(_config.window.width)),
-                random(0.01f * float(_config.window.height), 0.99f * float(_config.window.height))
+    // heads somewhere into the middle of the view, through the seam when that is shorter
+    Vector2 createVelocity(const Vector2& position) {
+        auto target = _camera.center + Vector2(
+                random(-0.3f, 0.3f) * _camera.size.x,
+                random(-0.3f, 0.3f) * _camera.size.y
         );
+        return _camera.delta(position, target).normalized();
+    }
 
-        // left-top corner
-        if (position.x < center.x && position.y < center.y) {
-            return position.x - position.y > 0 ? Vector2(position.x, 0) : Vector2(0, position.y);
+    Vector2 createSafePosition() {
+        auto position = createPosition();
+        for (int attempt = 1; attempt < SPAWN_ATTEMPTS && isNearPlayer(position); ++attempt) {
+            position = createPosition();
         }
+        return position;
+    }
 
-        // right-top corner
-        if (position.x >= center.x && position.y < center.y) {
-            return (screen.x - position.x) - position.y > 0 ? Vector2(position.x, 0) : Vector2(0, position.y);
-        }
+    bool isNearPlayer(const Vector2& position) {
+        _spatialIndex.queryRadius(position, _config.gameplay.spawnSafeDistance, _nearby);
+        return std::any_of(_nearby.begin(), _nearby.end(), [this](const ecs::Entity& entity) {
+            return _playerTagPool->has(entity);
+        });
+    }
 
-        // left-bottom corner
-        if (position.x < center.x && position.y >= center.y) {
-            return position.x - (screen.y - position.y) > 0 ? Vector2(position.x, 0) : Vector2(0, position.y);
-        }
+    // anywhere in the world, a position the player can see is pushed out through the closest view edge
+    Vector2 createPosition() {
+        auto position = Vector2T(random(0.f, _config.world.width), random(0.f, _config.world.height));
 
-        // right-bottom corner
-        if (position.x >= center.x && position.y >= center.y) {
-            return (screen.x - position.x) - (screen.y - position.y) > 0 ? Vector2(position.x, 0) : Vector2(0, position.y);
+        auto margin = _config.asteroid.baseRadius + MASS_RADIUS;
+        auto halfSize = _camera.size * 0.5f + Vector2(margin, margin);
+        auto delta = _camera.delta(_camera.center, position);
+        if (std::abs(delta.x) >= halfSize.x || std::abs(delta.y) >= halfSize.y) {
+            return position;
         }
 
-        return position;
-    }
-
-    std::shared_ptr<sf::ConvexShape> createShape(float radius, uint pointCount, Vector2 position) {
-        auto shape = std::make_shared<sf::ConvexShape>();
-        shape->setPointCount(pointCount);
-
-        auto angleStep = 360.f / float (pointCount);
-        for (auto i = 0; i < pointCount; ++i) {
-            auto point = Vector2(0, 1).rotate(angleStep * float(i)) * random(radius * 0.7f, radius * 1.3f);
-            shape->setPoint(i, point());
+        if (halfSize.x - std::abs(delta.x) < halfSize.y - std::abs(delta.y)) {
+            delta.x = std::copysign(halfSize.x, delta.x);
+        } else {
+            delta.y = std::copysign(halfSize.y, delta.y);
         }
+        return _camera.wrap(_camera.center + delta);
+    }
 
-        shape->setPosition(position());
-        shape->setFillColor(_config.asteroid.fillColor());
-        shape->setOutlineColor(_config.asteroid.outlineColor());
-        shape->setOutlineThickness(_config.asteroid.outlineThickness);
-        shape->setOrigin(0.5f, 0.5f);
-        return shape;
+    CGeometry createGeometry(uint pointCount) {
+        return {
+                _geometries.asteroid(pointCount, random(0u, _geometries.asteroidVariants)),
+                _config.asteroid.fillColor(),
+                _config.asteroid.outlineColor(),
+                _config.asteroid.outlineThickness
+        };
     }
 };
 
@@ -13,97 +13,75 @@
 #include "../../data/color.h"
 #include "../../data/vector2.h"
 
+#include "../../ecs/prefab.h"
 #include "../../ecs/systems.h"
 
+#include "../geometries.h"
+
 class SpawnPlayerSystem : public ecs::IInitSystem, public ecs::IRunSystem {
 private:
     const std::string _name = "SpawnPlayerSystem";
     const Config& _config;
+    const Geometries& _geometries;
+    const ecs::Prefab& _prefab;
 
-    std::shared_ptr<ecs::Filter> _filter = nullptr;
+    // set when the player is gone, no need to look for one every frame
+    bool _playerMissing = true;
 
-    std::shared_ptr<ecs::Pool<CPlayerTag>> _playerTagPool = nullptr;
-    std::shared_ptr<ecs::Pool<CShape>> _shapePool = nullptr;
-    std::shared_ptr<ecs::Pool<CDrawable>> _drawablePool = nullptr;
-    std::shared_ptr<ecs::Pool<CInput>> _inputPool = nullptr;
+    std::shared_ptr<ecs::Pool<CGeometry>> _geometryPool = nullptr;
     std::shared_ptr<ecs::Pool<CMoveSpeed>> _moveSpeedPool = nullptr;
     std::shared_ptr<ecs::Pool<CTransform>> _transformPool = nullptr;
-    std::shared_ptr<ecs::Pool<CVelocity>> _velocityPool = nullptr;
     std::shared_ptr<ecs::Pool<CMoveAcceleration>> _moveAccelerationPool = nullptr;
     std::shared_ptr<ecs::Pool<CSpinSpeed>> _spinSpeedPool = nullptr;
     std::shared_ptr<ecs::Pool<CCollider>> _colliderPool = nullptr;
 
 public:
-    explicit SpawnPlayerSystem(const Config& config)
+    SpawnPlayerSystem(const Config& config, const Geometries& geometries, const ecs::Prefab& prefab)
     : _config(config)
+    , _geometries(geometries)
+    , _prefab(prefab)
     {
     }
 
     [[nodiscard]] const std::string& name() const override { return _name; }
 
     void init(ecs::World& world) override {
-        _playerTagPool = world.pool<CPlayerTag>();
         _transformPool = world.pool<CTransform>();
-        _velocityPool = world.pool<CVelocity>();
-        _shapePool = world.pool<CShape>();
-        _inputPool = world.pool<CInput>();
+        _geometryPool = world.pool<CGeometry>();
         _moveSpeedPool = world.pool<CMoveSpeed>();
         _moveAccelerationPool = world.pool<CMoveAcceleration>();
         _spinSpeedPool = world.pool<CSpinSpeed>();
         _colliderPool = world.pool<CCollider>();
-        _drawablePool = world.pool<CDrawable>();
 
-        _filter = world.buildFilter()
-                .include<CPlayerTag>()
-                .build();
+        world.onRemove<CPlayerTag>([this](const ecs::Entities&) { _playerMissing = true; });
     }
 
     void run(ecs::World& world, const sf::Time& dt) override {
-        if (_filter->entities().empty()) {
+        if (_playerMissing) {
             createNewPlayer(world);
+            _playerMissing = false;
         }
     }
 
 private:
 
     void createNewPlayer(ecs::World& world) {
-        auto entity = world.newEntity();
-
-        auto position = Vector2 (floor(_config.window.width), floor(_config.window.height)) * .5f;
-
-        _playerTagPool->add(entity);
-        _transformPool->add(entity, CTransform(position));
-
-        auto shape = createShape(position);
-        _shapePool->add(entity, {shape });
-        _drawablePool->add(entity, {shape });
-
-        _inputPool->add(entity);
-        _velocityPool->add(entity);
-
-        _spinSpeedPool->add(entity, { _config.player.spinSpeed });
-        _moveSpeedPool->add(entity, { _config.player.moveSpeed });
-        _moveAccelerationPool->add(entity, { _config.player.moveAcceleration });
-        _colliderPool->add(entity, { _config.player.radius });
-    }
-
-    std::shared_ptr<sf::ConvexShape> createShape(Vector2 position) {
-        auto shape = std::make_shared<sf::ConvexShape>();
-        shape->setPointCount(4);
-
-        shape->setPoint(0, sf::Vector2f(0.f, -1.f) * _config.player.radius);
-        shape->setPoint(1, sf::Vector2f(0.7f, 1.f) * _config.player.radius);
-        shape->setPoint(2, sf::Vector2f(0.f, 0.5f) * _config.player.radius);
-        shape->setPoint(3, sf::Vector2f(-0.7f, 1.f) * _config.player.radius);
-
-        shape->setOrigin(0.5f, 0.5f);
-
-        shape->setPosition(position());
-        shape->setFillColor(_config.player.fillColor());
-        shape->setOutlineColor(_config.player.outlineColor());
-        shape->setOutlineThickness(_config.player.outlineThickness);
-
-        return shape;
+        auto position = Vector2 (floor(_config.world.width), floor(_config.world.height)) * .5f;
+
+        world.instantiate(_prefab, 1, [this, &position](const ecs::Entity& entity, size_t) {
+            _transformPool->write(entity) = CTransform(position, 0, _config.player.radius);
+            _geometryPool->write(entity) = {
+                    _geometries.player,
+                    _config.player.fillColor(),
+                    _config.player.outlineColor(),
+                    _config.player.outlineThickness
+            };
+
+            _spinSpeedPool->write(entity) = { _config.player.spinSpeed };
+            _moveSpeedPool->write(entity) = { _config.player.moveSpeed };
+            _moveAccelerationPool->write(entity) = { _config.player.moveAcceleration };
+            _colliderPool->write(entity) = { _config.player.radius };
+        });
     }
 };
 
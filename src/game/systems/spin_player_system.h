@@ -41,7 +41,7 @@ public:
 
     void run(ecs::World& world, const sf::Time& dt) override {
         for (auto entity : _filter->entities()) {
-            auto & transform = _transformPool->get(entity);
+            auto transform = _transformPool->write(entity);
 
             const auto & speed= _speedPool->get(entity);
             const auto & input = _inputPool->get(entity);
@@ -0,0 +1,34 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef ECS_UPDATE_PARTICLES_SYSTEM_H
+#define ECS_UPDATE_PARTICLES_SYSTEM_H
+
+#include "../../ecs/systems.h"
+#include "../../particles/particle_pool.h"
+
+#include "../config/config.h"
+
+class UpdateParticlesSystem : public ecs::IRunSystem {
+private:
+    const std::string _name = "UpdateParticlesSystem";
+
+    const Config& _config;
+    particles::ParticlePool& _fragments;
+
+public:
+    UpdateParticlesSystem(const Config& config, particles::ParticlePool& fragments)
+    : _config(config)
+    , _fragments(fragments)
+    {
+    }
+
+    [[nodiscard]] const std::string& name() const override { return _name; }
+
+    void run(ecs::World& world, const sf::Time& dt) override {
+        _fragments.update(_config.world.width, _config.world.height);
+    }
+};
+
+#endif //ECS_UPDATE_PARTICLES_SYSTEM_H
@@ -20,7 +20,6 @@ private:
     std::shared_ptr<ecs::Filter> _filter = nullptr;
 
     std::shared_ptr<ecs::Pool<CTransform>> _transformPool = nullptr;
-    std::shared_ptr<ecs::Pool<CShape>> _shapePool;
 
 public:
     explicit UpdateShapeTransformSystem(const Config& config)
@@ -32,28 +31,26 @@ public:
 
     void init(ecs::World& world) override {
         _transformPool = world.pool<CTransform>();
-        _shapePool = world.pool<CShape>();
 
+        // only what moved since the last run can be outside the world
         _filter = world.buildFilter()
-                .include<CTransform>()
-                .include<CShape>()
+                .changed<CTransform>()
+                .include<CGeometry>()
                 .build();
     }
 
     void run(ecs::World& world, const sf::Time& dt) override {
         for (auto entity : _filter->entities()) {
-            auto &transform = _transformPool->get(entity);
-            auto &shape = _shapePool->get(entity);
+            const auto &position = std::as_const(*_transformPool).get(entity).position;
+            if (position.x >= 0 && position.x <= _config.world.width && position.y >= 0 && position.y <= _config.world.height) continue;
 
-            if (transform.position.x < 0) transform.position.x += float(_config.window.width);
-            if (transform.position.x > float(_config.window.width)) transform.position.x -= float(_config.window.width);
+            auto transform = _transformPool->write(entity);
 
-            if (transform.position.y < 0) transform.position.y += float(_config.window.height);
-            if (transform.position.y > float(_config.window.height)) transform.position.y -= float(_config.window.height);
+            if (transform.position.x < 0) transform.position.x += _config.world.width;
+            if (transform.position.x > _config.world.width) transform.position.x -= _config.world.width;
 
-            shape.value->setPosition(transform.position());
-            shape.value->setRotation(transform.rotation);
-            shape.value->setScale(transform.scale, transform.scale);
+            if (transform.position.y < 0) transform.position.y += _config.world.height;
+            if (transform.position.y > _config.world.height) transform.position.y -= _config.world.height;
         }
     }
 };
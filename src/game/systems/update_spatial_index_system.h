@@ -0,0 +1,72 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef ECS_UPDATE_SPATIAL_INDEX_SYSTEM_H
+#define ECS_UPDATE_SPATIAL_INDEX_SYSTEM_H
+
+#include "../components/components.h"
+
+#include "../../data/vector2.h"
+#include "../../ecs/systems.h"
+#include "../../physics/spatial_index.h"
+
+#include "../config/config.h"
+
+class UpdateSpatialIndexSystem : public ecs::IInitSystem, public ecs::IRunSystem {
+private:
+    const std::string _name = "UpdateSpatialIndexSystem";
+
+    const Config& _config;
+    physics::SpatialIndex& _spatialIndex;
+
+    std::shared_ptr<ecs::Filter> _filter;
+
+    std::shared_ptr<ecs::Pool<CCollider>> _colliderPool;
+    std::shared_ptr<const ecs::Pool<CTransform>> _transformPool;
+    std::shared_ptr<ecs::Pool<CVelocity>> _velocityPool;
+
+public:
+    UpdateSpatialIndexSystem(const Config& config, physics::SpatialIndex& spatialIndex)
+    : _config(config)
+    , _spatialIndex(spatialIndex)
+    {
+    }
+
+    [[nodiscard]] const std::string& name() const override { return _name; }
+
+    void init(ecs::World &world) override {
+        _transformPool = world.pool<CTransform>();
+        _colliderPool = world.pool<CCollider>();
+        _velocityPool = world.pool<CVelocity>();
+
+        _filter = world.buildFilter()
+                .include<CCollider>()
+                .include<CTransform>()
+                .build();
+    }
+
+    void run(ecs::World &world, const sf::Time& dt) override {
+        // the playfield wraps around the world edges, so does the index
+        _spatialIndex.reset(_config.world.width, _config.world.height);
+        for (auto entity: _filter->entities()) {
+            const auto &transform = _transformPool->get(entity);
+            const auto &collider = _colliderPool->get(entity);
+
+            // MoveSystem already applied this tick's velocity, an entity moving further than its
+            // radius is swept from where it started so it can not tunnel through small objects.
+            // The index does not sweep an entity new to it, a projectile would start inside the ship
+            // that fired it.
+            auto sweep = Vector2();
+            if (_velocityPool->has(entity)) {
+                const auto velocity = std::as_const(*_velocityPool).get(entity);
+                if (velocity.value.sqrMagnitude() > collider.value * collider.value) sweep = velocity.value;
+            }
+
+            _spatialIndex.insert(entity, transform.position, collider.value, sweep);
+        }
+        _spatialIndex.build();
+    }
+};
+
+#endif //ECS_UPDATE_SPATIAL_INDEX_SYSTEM_H
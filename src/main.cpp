@@ -1,10 +1,19 @@
+#include <iostream>
+#include <stdexcept>
+
 #include "game/game.h"
 
 int main(int argc, char *argv[]) {
     auto path = (argc >= 2) ? argv[1] : "./res/config.ini";
-    Game game(path);
+    try {
+        Game game(path);
 
-    game.run();
+        game.run();
+    } catch (const std::exception& e) {
+        // a missing or broken config.ini or prefabs.ini
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,159 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef PARTICLES_PARTICLE_POOL_H
+#define PARTICLES_PARTICLE_POOL_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include "../data/vector2.h"
+#include "../render/geometry_library.h"
+
+namespace particles {
+
+    // Short-living decorative shapes that only move, spin, fade and die, kept out of the ECS.
+    //
+    // Every attribute lives in its own array, so an update is a handful of straight loops over
+    // floats the compiler can vectorize. The capacity is fixed up front, emitting into a full pool
+    // drops the particle, and a dead particle is replaced by the last one, so the alive particles
+    // always fill [0, size) and nothing allocates after the construction.
+    class ParticlePool {
+    private:
+        size_t _capacity;
+        size_t _size = 0;
+
+        std::vector<float> _x;
+        std::vector<float> _y;
+        std::vector<float> _velocityX;
+        std::vector<float> _velocityY;
+        std::vector<float> _rotation;
+        std::vector<float> _spin;
+        std::vector<float> _scale;
+        std::vector<uint32_t> _age;
+        std::vector<uint32_t> _lifespan;
+        std::vector<render::GeometryId> _geometry;
+
+        // shared by every particle of the pool, the alpha fades with the age
+        sf::Color _fillColor;
+        sf::Color _outlineColor;
+        float _outlineThickness;
+
+    public:
+        ParticlePool(size_t capacity, const sf::Color &fillColor, const sf::Color &outlineColor, float outlineThickness)
+        : _capacity(capacity)
+        , _x(capacity)
+        , _y(capacity)
+        , _velocityX(capacity)
+        , _velocityY(capacity)
+        , _rotation(capacity)
+        , _spin(capacity)
+        , _scale(capacity)
+        , _age(capacity)
+        , _lifespan(capacity)
+        , _geometry(capacity)
+        , _fillColor(fillColor)
+        , _outlineColor(outlineColor)
+        , _outlineThickness(outlineThickness)
+        {
+        }
+
+        // lifespan - in ticks, false when the pool is full
+        bool emit(const Vector2 &position, const Vector2 &velocity, float spin, float scale, render::GeometryId geometry, uint32_t lifespan) {
+            if (_size == _capacity) return false;
+
+            auto i = _size++;
+            _x[i] = position.x;
+            _y[i] = position.y;
+            _velocityX[i] = velocity.x;
+            _velocityY[i] = velocity.y;
+            _rotation[i] = 0;
+            _spin[i] = spin;
+            _scale[i] = scale;
+            _age[i] = 0;
+            _lifespan[i] = lifespan;
+            _geometry[i] = geometry;
+            return true;
+        }
+
+        // one tick, positions are wrapped into [0, width) x [0, height)
+        void update(float width, float height) {
+            for (size_t i = _size; i-- > 0;) {
+                if (_age[i] >= _lifespan[i]) remove(i);
+            }
+
+            auto count = _size;
+            auto *x = _x.data();
+            auto *y = _y.data();
+            const auto *velocityX = _velocityX.data();
+            const auto *velocityY = _velocityY.data();
+            auto *rotation = _rotation.data();
+            const auto *spin = _spin.data();
+            auto *age = _age.data();
+
+            for (size_t i = 0; i < count; ++i) age[i] += 1;
+            for (size_t i = 0; i < count; ++i) x[i] += velocityX[i];
+            for (size_t i = 0; i < count; ++i) y[i] += velocityY[i];
+            for (size_t i = 0; i < count; ++i) x[i] -= width * std::floor(x[i] / width);
+            for (size_t i = 0; i < count; ++i) y[i] -= height * std::floor(y[i] / height);
+            for (size_t i = 0; i < count; ++i) rotation[i] += spin[i];
+            for (size_t i = 0; i < count; ++i) rotation[i] -= 360.f * std::floor(rotation[i] / 360.f);
+        }
+
+        void clear() { _size = 0; }
+
+        [[nodiscard]] size_t size() const { return _size; }
+
+        [[nodiscard]] size_t capacity() const { return _capacity; }
+
+        [[nodiscard]] Vector2 position(size_t i) const { return { _x[i], _y[i] }; }
+
+        [[nodiscard]] float rotation(size_t i) const { return _rotation[i]; }
+
+        [[nodiscard]] float scale(size_t i) const { return _scale[i]; }
+
+        [[nodiscard]] render::GeometryId geometry(size_t i) const { return _geometry[i]; }
+
+        [[nodiscard]] float outlineThickness() const { return _outlineThickness; }
+
+        // the fill loses 255 / lifespan of alpha every tick and the outline stays one step behind it
+        [[nodiscard]] sf::Color fillColor(size_t i) const {
+            auto color = _fillColor;
+            color.a = fade(_fillColor.a, i, 0);
+            return color;
+        }
+
+        [[nodiscard]] sf::Color outlineColor(size_t i) const {
+            auto color = _outlineColor;
+            color.a = fade(_fillColor.a, i, 1);
+            return color;
+        }
+
+    private:
+        void remove(size_t i) {
+            auto last = --_size;
+            _x[i] = _x[last];
+            _y[i] = _y[last];
+            _velocityX[i] = _velocityX[last];
+            _velocityY[i] = _velocityY[last];
+            _rotation[i] = _rotation[last];
+            _spin[i] = _spin[last];
+            _scale[i] = _scale[last];
+            _age[i] = _age[last];
+            _lifespan[i] = _lifespan[last];
+            _geometry[i] = _geometry[last];
+        }
+
+        [[nodiscard]] uint8_t fade(uint8_t alpha, size_t i, uint32_t extraSteps) const {
+            auto step = int(255 / std::max(_lifespan[i], 1u));
+            return uint8_t(std::clamp(int(alpha) - step * int(_age[i] + extraSteps), 0, 255));
+        }
+    };
+}
+
+#endif //PARTICLES_PARTICLE_POOL_H
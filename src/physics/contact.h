@@ -0,0 +1,60 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef PHYSICS_CONTACT_H
+#define PHYSICS_CONTACT_H
+
+#include <algorithm>
+#include <vector>
+
+#include "../ecs/types.h"
+#include "../data/vector2.h"
+
+namespace physics {
+
+    struct Contact {
+        ecs::Entity a;
+        ecs::Entity b;
+        Vector2 normal;     // points from a to b
+        float depth;
+
+        [[nodiscard]] ecs::Entity other(const ecs::Entity &entity) const { return entity == a ? b : a; }
+
+        // normal pointing from the given entity towards the other one
+        [[nodiscard]] Vector2 normalFrom(const ecs::Entity &entity) const { return entity == a ? normal : Vector2(-normal.x, -normal.y); }
+    };
+
+    // Flat list of contacts found during the current tick. Cleared (not freed) every tick so the
+    // storage is reused once it has grown to the size of a busy frame.
+    class Contacts {
+    private:
+        std::vector<Contact> _contacts;
+
+    public:
+        void clear() { _contacts.clear(); }
+
+        void add(const Contact &contact) { _contacts.push_back(contact); }
+
+        void append(const Contacts &contacts) {
+            _contacts.insert(_contacts.end(), contacts._contacts.begin(), contacts._contacts.end());
+        }
+
+        // order by entity pair, so the list does not depend on how the pairs were found
+        void sort() {
+            std::sort(_contacts.begin(), _contacts.end(), [](const Contact &l, const Contact &r) {
+                return l.a != r.a ? l.a < r.a : l.b < r.b;
+            });
+        }
+
+        [[nodiscard]] size_t size() const { return _contacts.size(); }
+
+        [[nodiscard]] bool empty() const { return _contacts.empty(); }
+
+        [[nodiscard]] std::vector<Contact>::const_iterator begin() const { return _contacts.begin(); }
+
+        [[nodiscard]] std::vector<Contact>::const_iterator end() const { return _contacts.end(); }
+    };
+}
+
+#endif //PHYSICS_CONTACT_H
@@ -0,0 +1,362 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef PHYSICS_SPATIAL_INDEX_H
+#define PHYSICS_SPATIAL_INDEX_H
+
+#include <cmath>
+#include <vector>
+
+#include "../ecs/types.h"
+#include "../data/vector2.h"
+
+namespace physics {
+
+    struct Proxy {
+        ecs::Entity entity;
+        Vector2 position;
+        float radius;
+        Vector2 sweep;      // displacement during the tick, zero unless the proxy is swept
+        Vector2 center;     // middle of the sweep, the proxy is binned by it
+    };
+
+    struct QueryHit {
+        ecs::Entity entity;
+        float distance;
+    };
+
+    // Uniform grid over a toroidal world, rebuilt once per tick and shared by every system that
+    // needs to find objects by position. Every proxy is stored in the cell of its center and the
+    // cells are at least one max diameter wide, so a pair can only overlap when it sits in the same
+    // or in adjacent cells. Neighbour cells are addressed modulo the grid size, so the cells on the
+    // opposite edge are the neighbours of a border cell and pairs across the seam are found without
+    // any extra work for the proxies away from the borders.
+    //
+    // Fast movers are inserted with their displacement for the tick. They are binned by the middle
+    // of the sweep with the radius of the circle enclosing it, so the grid pairs them with
+    // everything their swept capsule can touch. An entity that was not in the previous build is not
+    // swept, it was spawned where it is now and did not come from anywhere the index knows.
+    //
+    // Queries only read the grid and write to the caller's buffers, they never allocate once the
+    // buffers have grown and can run from several threads at once.
+    class SpatialIndex {
+    private:
+        // half of the 8-neighbourhood, so every pair of cells is visited once
+        static constexpr int NEIGHBOURS[4][2] = { { 1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 } };
+
+        // keeps the grid small when only tiny colliders are alive
+        static constexpr float MIN_CELL_SIZE = 32.f;
+
+        float _width = 0;
+        float _height = 0;
+
+        int _columns = 1;
+        int _rows = 1;
+        float _cellWidth = 0;
+        float _cellHeight = 0;
+        float _maxExtent = 0;
+
+        std::vector<Proxy> _proxies;
+        std::vector<uint32_t> _proxyCell;
+        std::vector<uint32_t> _cellStart;
+        std::vector<uint32_t> _cellProxies;
+
+        // the last entity inserted with the index and the build it went into, by entity index
+        struct Indexed {
+            ecs::Entity entity = 0;
+            uint32_t build = 0;
+        };
+        std::vector<Indexed> _indexed;
+        uint32_t _builds = 0;
+
+    public:
+        // world size, positions are wrapped into [0, width) x [0, height)
+        void reset(float width, float height) {
+            _width = width;
+            _height = height;
+            _maxExtent = 0;
+            _proxies.clear();
+        }
+
+        // sweep - displacement that brought the entity to the position during this tick, dropped
+        // when the entity is new to the index
+        void insert(const ecs::Entity &entity, const Vector2 &position, float radius, Vector2 sweep = Vector2()) {
+            auto index = ecs::entityIndex(entity);
+            if (index >= _indexed.size()) _indexed.resize(index + 1);
+
+            auto &indexed = _indexed[index];
+            if (indexed.entity != entity || indexed.build != _builds) sweep = Vector2();
+            indexed = { entity, _builds + 1 };
+
+            auto halfSweep = sweep * 0.5f;
+            auto center = wrap(position - halfSweep);
+
+            // position stays next to the center even when only one of them crossed the seam
+            _proxies.push_back({ entity, center + halfSweep, radius, sweep, center });
+            _maxExtent = std::max(_maxExtent, radius + halfSweep.magnitude());
+        }
+
+        [[nodiscard]] const std::vector<Proxy>& proxies() const { return _proxies; }
+
+        // sort the proxies into cells, must be called after the last insert and before the queries
+        void build() {
+            ++_builds;
+            auto cellSize = std::max(2.f * _maxExtent, MIN_CELL_SIZE);
+
+            // a grid narrower than three cells would visit the same neighbour twice,
+            // such a dimension collapses into a single cell
+            _columns = std::max(int(_width / cellSize), 1);
+            _rows = std::max(int(_height / cellSize), 1);
+            if (_columns < 3) _columns = 1;
+            if (_rows < 3) _rows = 1;
+
+            _cellWidth = _width / float(_columns);
+            _cellHeight = _height / float(_rows);
+
+            auto cellCount = size_t(_columns * _rows);
+            _cellStart.assign(cellCount + 1, 0);
+            _proxyCell.resize(_proxies.size());
+            _cellProxies.resize(_proxies.size());
+
+            // counting sort by cell
+            for (size_t i = 0; i < _proxies.size(); ++i) {
+                auto column = std::min(int(_proxies[i].center.x / _cellWidth), _columns - 1);
+                auto row = std::min(int(_proxies[i].center.y / _cellHeight), _rows - 1);
+
+                _proxyCell[i] = uint32_t(row * _columns + column);
+                ++_cellStart[_proxyCell[i] + 1];
+            }
+            for (size_t cell = 0; cell < cellCount; ++cell) {
+                _cellStart[cell + 1] += _cellStart[cell];
+            }
+            for (size_t i = 0; i < _proxies.size(); ++i) {
+                _cellProxies[_cellStart[_proxyCell[i]]++] = uint32_t(i);
+            }
+            // scatter advanced every start to the next cell, shift them back
+            for (size_t cell = cellCount; cell > 0; --cell) {
+                _cellStart[cell] = _cellStart[cell - 1];
+            }
+            _cellStart[0] = 0;
+        }
+
+        // Calls fn(a, b, shift) for every pair of proxies close enough to overlap. The shift has to be
+        // added to b's position to bring it next to a, it is zero unless the pair crosses the seam.
+        template<typename Fn>
+        void forEachPair(Fn &&fn) const {
+            forEachPairInRows(0, _rows, fn);
+        }
+
+        // Same as forEachPair, limited to the pairs owned by the cell rows in [rowBegin, rowEnd).
+        // Disjoint row ranges visit disjoint pairs and only read the grid, so they can run in parallel.
+        template<typename Fn>
+        void forEachPairInRows(int rowBegin, int rowEnd, Fn &&fn) const {
+            for (int row = rowBegin; row < rowEnd; ++row) {
+                for (int column = 0; column < _columns; ++column) {
+                    forEachPairInCell(row, column, fn);
+                }
+            }
+        }
+
+        [[nodiscard]] int rows() const { return _rows; }
+
+        // entities whose collider overlaps the circle
+        size_t queryRadius(const Vector2 &position, float radius, std::vector<ecs::Entity> &out) const {
+            out.clear();
+            auto center = wrap(position);
+            forEachInRect(center, { radius, radius }, [&](const Proxy &proxy, const Vector2 &shift) {
+                auto distance = radius + proxy.radius;
+                if ((proxy.position + shift - center).sqrMagnitude() < distance * distance) {
+                    out.push_back(proxy.entity);
+                }
+            });
+            return out.size();
+        }
+
+        // entities whose collider overlaps the box
+        size_t queryAabb(const Vector2 &min, const Vector2 &max, std::vector<ecs::Entity> &out) const {
+            out.clear();
+            auto halfSize = (max - min) * 0.5f;
+            auto center = wrap(min + halfSize);
+            forEachInRect(center, halfSize, [&](const Proxy &proxy, const Vector2 &shift) {
+                auto delta = proxy.position + shift - center;
+                auto closest = Vector2(
+                        std::clamp(delta.x, -halfSize.x, halfSize.x),
+                        std::clamp(delta.y, -halfSize.y, halfSize.y)
+                );
+                if ((delta - closest).sqrMagnitude() < proxy.radius * proxy.radius) {
+                    out.push_back(proxy.entity);
+                }
+            });
+            return out.size();
+        }
+
+        // up to count entities with the closest centers, sorted by distance
+        size_t nearest(const Vector2 &position, size_t count, std::vector<QueryHit> &out) const {
+            out.clear();
+            if (count == 0 || _proxies.empty()) return 0;
+
+            auto center = wrap(position);
+            auto worldRadius = std::max(_width, _height);
+
+            // grow the search circle until it holds enough candidates or covers the whole world
+            for (auto radius = std::max(_cellWidth, _cellHeight); ; radius *= 2.f) {
+                out.clear();
+                forEachInRect(center, { radius, radius }, [&](const Proxy &proxy, const Vector2 &shift) {
+                    auto distance = (proxy.position + shift - center).magnitude();
+                    if (distance <= radius) out.push_back({ proxy.entity, distance });
+                });
+                if (out.size() >= count || radius >= worldRadius) break;
+            }
+
+            count = std::min(count, out.size());
+            std::partial_sort(out.begin(), out.begin() + long(count), out.end(), [](const QueryHit &l, const QueryHit &r) {
+                return l.distance != r.distance ? l.distance < r.distance : l.entity < r.entity;
+            });
+            out.resize(count);
+            return count;
+        }
+
+        // first collider hit by the ray, direction has to be normalized
+        bool raycast(const Vector2 &origin, const Vector2 &direction, float maxDistance, QueryHit &hit) const {
+            hit = { 0, maxDistance };
+            auto found = false;
+            auto start = wrap(origin);
+            auto step = std::min(_cellWidth, _cellHeight);
+
+            // walk the ray one cell long segment at a time, a collider entered inside the segment
+            // has its position within max extent of it
+            for (float from = 0; from < maxDistance; from += step) {
+                auto to = std::min(from + step, maxDistance);
+                auto center = start + direction * ((from + to) * 0.5f);
+                auto halfSize = Vector2(std::abs(direction.x), std::abs(direction.y)) * ((to - from) * 0.5f);
+
+                forEachInRect(center, halfSize, [&](const Proxy &proxy, const Vector2 &shift) {
+                    // proxies are shifted next to the segment center, bring the origin along
+                    auto offset = start - (proxy.position + shift);
+                    auto b = offset.dot(direction);
+                    auto c = offset.sqrMagnitude() - proxy.radius * proxy.radius;
+                    if (c > 0 && b > 0) return;
+
+                    auto discriminant = b * b - c;
+                    if (discriminant < 0) return;
+
+                    auto distance = std::max(-b - std::sqrt(discriminant), 0.f);
+                    if (distance < hit.distance || (distance == hit.distance && found && proxy.entity < hit.entity)) {
+                        hit = { proxy.entity, distance };
+                        found = true;
+                    }
+                });
+
+                if (found && hit.distance <= to) break;
+            }
+            return found;
+        }
+
+    private:
+        static float wrap(float value, float size) {
+            if (value >= 0 && value < size) return value;
+            value -= size * std::floor(value / size);
+            return value < size ? value : 0;
+        }
+
+        [[nodiscard]] Vector2 wrap(const Vector2 &position) const {
+            return { wrap(position.x, _width), wrap(position.y, _height) };
+        }
+
+        static int floorDiv(int value, int size) {
+            return value >= 0 ? value / size : -((size - 1 - value) / size);
+        }
+
+        // Calls fn(proxy, shift) once for every proxy whose position may lie within max extent of the
+        // box around the wrapped center. Shifted proxies are the images closest to the box.
+        template<typename Fn>
+        void forEachInRect(const Vector2 &center, const Vector2 &halfSize, Fn &&fn) const {
+            if (_proxies.empty()) return;
+
+            auto columnBegin = int(std::floor((center.x - halfSize.x - _maxExtent) / _cellWidth));
+            auto columnEnd = int(std::floor((center.x + halfSize.x + _maxExtent) / _cellWidth));
+            auto rowBegin = int(std::floor((center.y - halfSize.y - _maxExtent) / _cellHeight));
+            auto rowEnd = int(std::floor((center.y + halfSize.y + _maxExtent) / _cellHeight));
+
+            // a box wider than the world visits every cell once, with the nearest image of each proxy
+            auto allColumns = columnEnd - columnBegin + 1 >= _columns;
+            auto allRows = rowEnd - rowBegin + 1 >= _rows;
+            if (allColumns) { columnBegin = 0; columnEnd = _columns - 1; }
+            if (allRows) { rowBegin = 0; rowEnd = _rows - 1; }
+
+            for (auto row = rowBegin; row <= rowEnd; ++row) {
+                auto rowWraps = floorDiv(row, _rows);
+                auto shiftY = float(rowWraps) * _height;
+                auto cellRow = row - rowWraps * _rows;
+
+                for (auto column = columnBegin; column <= columnEnd; ++column) {
+                    auto columnWraps = floorDiv(column, _columns);
+                    auto shiftX = float(columnWraps) * _width;
+                    auto cell = cellRow * _columns + column - columnWraps * _columns;
+
+                    for (auto i = _cellStart[cell]; i < _cellStart[cell + 1]; ++i) {
+                        const auto &proxy = _proxies[_cellProxies[i]];
+                        fn(proxy, Vector2(
+                                allColumns ? -_width * std::round((proxy.position.x - center.x) / _width) : shiftX,
+                                allRows ? -_height * std::round((proxy.position.y - center.y) / _height) : shiftY
+                        ));
+                    }
+                }
+            }
+        }
+
+        template<typename Fn>
+        void forEachPairInCell(int row, int column, Fn &fn) const {
+            auto cell = row * _columns + column;
+            auto begin = _cellStart[cell];
+            auto end = _cellStart[cell + 1];
+            if (begin == end) return;
+
+            // collapsed dimensions keep everything in one cell, pairs there need the nearest image
+            const bool nearestImage = _columns == 1 || _rows == 1;
+
+            for (auto i = begin; i < end; ++i) {
+                for (auto j = i + 1; j < end; ++j) {
+                    const auto &a = _proxies[_cellProxies[i]];
+                    const auto &b = _proxies[_cellProxies[j]];
+                    fn(a, b, nearestImage ? nearestImageShift(a, b) : Vector2());
+                }
+            }
+
+            for (const auto &offset: NEIGHBOURS) {
+                if (_columns == 1 && offset[0] != 0) continue;
+                if (_rows == 1 && offset[1] != 0) continue;
+
+                auto otherColumn = column + offset[0];
+                auto otherRow = row + offset[1];
+                Vector2 shift;
+
+                if (otherColumn < 0) { otherColumn += _columns; shift.x = -_width; }
+                if (otherColumn >= _columns) { otherColumn -= _columns; shift.x = _width; }
+                if (otherRow >= _rows) { otherRow -= _rows; shift.y = _height; }
+
+                auto otherCell = otherRow * _columns + otherColumn;
+                auto otherBegin = _cellStart[otherCell];
+                auto otherEnd = _cellStart[otherCell + 1];
+
+                for (auto i = begin; i < end; ++i) {
+                    for (auto j = otherBegin; j < otherEnd; ++j) {
+                        const auto &a = _proxies[_cellProxies[i]];
+                        const auto &b = _proxies[_cellProxies[j]];
+                        fn(a, b, nearestImage ? shift + nearestImageShift(a, b) : shift);
+                    }
+                }
+            }
+        }
+
+        [[nodiscard]] Vector2 nearestImageShift(const Proxy &a, const Proxy &b) const {
+            Vector2 shift;
+            if (_columns == 1) shift.x = -_width * std::round((b.center.x - a.center.x) / _width);
+            if (_rows == 1) shift.y = -_height * std::round((b.center.y - a.center.y) / _height);
+            return shift;
+        }
+    };
+}
+
+#endif //PHYSICS_SPATIAL_INDEX_H
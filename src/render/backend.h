@@ -0,0 +1,27 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef RENDER_BACKEND_H
+#define RENDER_BACKEND_H
+
+#include "command_list.h"
+
+namespace render {
+
+    // Consumer of the frames built by the game, it never sees the world itself
+    class IBackend {
+    public:
+        virtual ~IBackend() = default;
+
+        virtual void submit(const CommandList &commands) = 0;
+    };
+
+    // Drops every frame, measures the cost of the simulation and of building the command lists
+    class NullBackend : public IBackend {
+    public:
+        void submit(const CommandList &) override {}
+    };
+}
+
+#endif //RENDER_BACKEND_H
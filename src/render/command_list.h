@@ -0,0 +1,103 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef RENDER_COMMAND_LIST_H
+#define RENDER_COMMAND_LIST_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include "geometry_library.h"
+
+namespace render {
+
+    enum class Blend : uint8_t {
+        Alpha,
+        Add,
+    };
+
+    // One geometry from the library placed in the world. Plain data, so a frame can be recorded,
+    // replayed and handed to any backend.
+    struct RenderCommand {
+        GeometryId geometry;
+        sf::Vector2f position;
+        float rotation;             // degrees
+        float scale;
+        sf::Color fillColor;
+        sf::Color outlineColor;
+        float outlineThickness;     // local space, same as the geometry
+        uint8_t layer;
+        Blend blend;
+
+        // commands with the same state can share a draw call, the layer decides first
+        [[nodiscard]] uint16_t state() const { return uint16_t(layer) << 1 | uint16_t(blend); }
+
+        [[nodiscard]] sf::Transform transform() const {
+            sf::Transform matrix;
+            matrix.translate(position)
+                  .rotate(rotation)
+                  .scale(scale, scale);
+            return matrix;
+        }
+    };
+
+    // Everything a frame shows in world space and the view it is shown through.
+    // The storage is kept between frames, so a frame of the same size does not allocate.
+    class CommandList {
+    private:
+        static constexpr size_t STATES = 1 << 9;
+
+        sf::Vector2f _viewCenter;
+        sf::Vector2f _viewSize;
+        std::vector<RenderCommand> _commands;
+        std::vector<RenderCommand> _sorted;
+        std::vector<uint32_t> _stateStart = std::vector<uint32_t>(STATES + 1);
+
+    public:
+        void clear(const sf::Vector2f &viewCenter, const sf::Vector2f &viewSize) {
+            _viewCenter = viewCenter;
+            _viewSize = viewSize;
+            _commands.clear();
+        }
+
+        void add(const RenderCommand &command) { _commands.push_back(command); }
+
+        // groups the commands by state, lower layers first, keeping the submission order within a state
+        void sort() {
+            std::fill(_stateStart.begin(), _stateStart.end(), 0);
+            for (const auto &command: _commands) ++_stateStart[command.state() + 1];
+            for (size_t i = 1; i <= STATES; ++i) _stateStart[i] += _stateStart[i - 1];
+
+            _sorted.resize(_commands.size());
+            for (const auto &command: _commands) _sorted[_stateStart[command.state()]++] = command;
+            _commands.swap(_sorted);
+        }
+
+        // end of the run of commands starting at begin that share its state
+        [[nodiscard]] size_t stateEnd(size_t begin) const {
+            auto end = begin;
+            while (end < _commands.size() && _commands[end].state() == _commands[begin].state()) ++end;
+            return end;
+        }
+
+        [[nodiscard]] const sf::Vector2f &viewCenter() const { return _viewCenter; }
+
+        [[nodiscard]] const sf::Vector2f &viewSize() const { return _viewSize; }
+
+        [[nodiscard]] size_t size() const { return _commands.size(); }
+
+        [[nodiscard]] bool empty() const { return _commands.empty(); }
+
+        [[nodiscard]] const RenderCommand &operator[](size_t index) const { return _commands[index]; }
+
+        [[nodiscard]] std::vector<RenderCommand>::const_iterator begin() const { return _commands.begin(); }
+
+        [[nodiscard]] std::vector<RenderCommand>::const_iterator end() const { return _commands.end(); }
+    };
+}
+
+#endif //RENDER_COMMAND_LIST_H
@@ -0,0 +1,112 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef RENDER_GEOMETRY_LIBRARY_H
+#define RENDER_GEOMETRY_LIBRARY_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+namespace render {
+
+    typedef uint32_t GeometryId;
+
+    struct GeometryVertex {
+        sf::Vector2f point;
+        sf::Vector2f extrude;   // outline offset for a thickness of 1
+    };
+
+    struct Geometry {
+        uint32_t offset;
+        uint32_t count;
+        GeometryId simplified;  // cheaper outline of the same shape, itself when there is none
+    };
+
+    // Immutable local-space convex outlines shared by every entity drawn with them. The outline
+    // extrusion is computed once here, the same way sf::Shape does it on every update.
+    class GeometryLibrary {
+    private:
+        std::vector<GeometryVertex> _vertices;
+        std::vector<Geometry> _geometries;
+
+    public:
+        GeometryId add(const std::vector<sf::Vector2f> &points) {
+            auto offset = uint32_t(_vertices.size());
+            auto count = points.size();
+
+            sf::Vector2f center;
+            for (const auto &point: points) center = center + point;
+            center = center * (1.f / float(count));
+
+            for (size_t i = 0; i < count; ++i) {
+                _vertices.push_back({ points[i], extrude(points[(i + count - 1) % count], points[i], points[(i + 1) % count], center) });
+            }
+
+            auto id = GeometryId(_geometries.size());
+            _geometries.push_back({ offset, uint32_t(count), id });
+            return id;
+        }
+
+        // adds a copy of the source outline keeping pointCount of its points, evenly spread,
+        // and makes it the simplified version of the source
+        GeometryId addSimplified(GeometryId source, size_t pointCount) {
+            auto count = _geometries[source].count;
+            pointCount = std::clamp<size_t>(pointCount, 3, count);
+
+            std::vector<sf::Vector2f> points(pointCount);
+            for (size_t i = 0; i < pointCount; ++i) {
+                points[i] = _vertices[_geometries[source].offset + i * count / pointCount].point;
+            }
+
+            auto id = add(points);
+            _geometries[source].simplified = id;
+            return id;
+        }
+
+        [[nodiscard]] const Geometry &geometry(GeometryId id) const { return _geometries[id]; }
+
+        [[nodiscard]] GeometryId simplified(GeometryId id) const { return _geometries[id].simplified; }
+
+        [[nodiscard]] const GeometryVertex *vertices(GeometryId id) const { return _vertices.data() + _geometries[id].offset; }
+
+        [[nodiscard]] size_t size() const { return _geometries.size(); }
+
+        // regular polygon with the first point straight up
+        static std::vector<sf::Vector2f> polygon(size_t pointCount, float radius = 1.f) {
+            std::vector<sf::Vector2f> points(pointCount);
+            for (size_t i = 0; i < pointCount; ++i) {
+                auto angle = float(i) * 2.f * 3.14159265f / float(pointCount);
+                points[i] = sf::Vector2f(std::sin(angle), -std::cos(angle)) * radius;
+            }
+            return points;
+        }
+
+    private:
+        // p1 moved outwards along the average normal of its two edges
+        static sf::Vector2f extrude(const sf::Vector2f &p0, const sf::Vector2f &p1, const sf::Vector2f &p2, const sf::Vector2f &center) {
+            auto n1 = normal(p0, p1);
+            auto n2 = normal(p1, p2);
+
+            // the point order decides where the outside is
+            auto inwards = center - p1;
+            if (n1.x * inwards.x + n1.y * inwards.y > 0) n1 = sf::Vector2f(-n1.x, -n1.y);
+            if (n2.x * inwards.x + n2.y * inwards.y > 0) n2 = sf::Vector2f(-n2.x, -n2.y);
+
+            auto factor = 1.f + (n1.x * n2.x + n1.y * n2.y);
+            return (n1 + n2) * (1.f / factor);
+        }
+
+        static sf::Vector2f normal(const sf::Vector2f &p1, const sf::Vector2f &p2) {
+            auto n = sf::Vector2f(p1.y - p2.y, p2.x - p1.x);
+            auto length = std::sqrt(n.x * n.x + n.y * n.y);
+            return length != 0.f ? n * (1.f / length) : n;
+        }
+    };
+}
+
+#endif //RENDER_GEOMETRY_LIBRARY_H
@@ -0,0 +1,76 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef RENDER_LOD_POLICY_H
+#define RENDER_LOD_POLICY_H
+
+#include <algorithm>
+#include <cstdint>
+
+namespace render {
+
+    enum class Lod : uint8_t {
+        Full,           // the geometry as it is
+        Simplified,     // the simplified geometry
+        Fill,           // the simplified geometry without the outline
+    };
+
+    // Picks the level of detail of a shape by its radius on screen. The radius thresholds grow
+    // while the frames take longer than the budget and shrink back once they fit into it, so
+    // the number of vertices stays bounded when the scene gets crowded.
+    class LodPolicy {
+    private:
+        // boost change per frame over the budget and per frame well under it
+        static constexpr float BOOST_UP = 0.05f;
+        static constexpr float BOOST_DOWN = 0.02f;
+        // share of the budget a frame has to fit into before the boost goes down
+        static constexpr float RELAX = 0.8f;
+        // weight of the last frame in the smoothed frame time
+        static constexpr float SMOOTHING = 0.1f;
+
+        float _simplifyRadius;
+        float _fillRadius;
+        float _budget;
+        float _maxBoost;
+
+        float _frameTime = 0;
+        float _boost = 1;
+
+    public:
+        // simplifyRadius - radius in pixels below which the simplified geometry is used
+        // fillRadius - radius in pixels below which the outline is dropped
+        // budget - frame time in milliseconds
+        // maxBoost - the largest factor the thresholds are multiplied by when over the budget
+        LodPolicy(float simplifyRadius, float fillRadius, float budget, float maxBoost)
+        : _simplifyRadius(simplifyRadius)
+        , _fillRadius(fillRadius)
+        , _budget(budget)
+        , _maxBoost(std::max(maxBoost, 1.f))
+        {
+        }
+
+        // milliseconds spent on the last frame, without the time waiting for the display
+        void frame(float milliseconds) {
+            _frameTime += (milliseconds - _frameTime) * SMOOTHING;
+
+            if (_frameTime > _budget) {
+                _boost = std::min(_boost + BOOST_UP, _maxBoost);
+            } else if (_frameTime < _budget * RELAX) {
+                _boost = std::max(_boost - BOOST_DOWN, 1.f);
+            }
+        }
+
+        [[nodiscard]] Lod level(float screenRadius) const {
+            if (screenRadius < _fillRadius * _boost) return Lod::Fill;
+            if (screenRadius < _simplifyRadius * _boost) return Lod::Simplified;
+            return Lod::Full;
+        }
+
+        [[nodiscard]] float boost() const { return _boost; }
+
+        [[nodiscard]] float frameTime() const { return _frameTime; }
+    };
+}
+
+#endif //RENDER_LOD_POLICY_H
@@ -0,0 +1,121 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef RENDER_RECORDING_H
+#define RENDER_RECORDING_H
+
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "backend.h"
+
+namespace render {
+
+    // Binary stream of frames, in the byte order of the machine that wrote it:
+    //   header: magic, version
+    //   frame:  command count, view center, view size, commands
+    namespace recording {
+        static constexpr uint32_t MAGIC = 0x52434549;   // "IECR"
+        static constexpr uint32_t VERSION = 2;
+    }
+
+    // Appends every submitted frame to a file, the recording can be replayed later to any backend
+    // without running the game
+    class RecordingBackend : public IBackend {
+    private:
+        std::ofstream _stream;
+        size_t _frames = 0;
+
+    public:
+        explicit RecordingBackend(const std::string &path)
+        : _stream(path, std::ios::binary | std::ios::trunc)
+        {
+            if (!_stream) throw std::runtime_error("Can not open the render recording " + path);
+
+            write(recording::MAGIC);
+            write(recording::VERSION);
+        }
+
+        [[nodiscard]] size_t frames() const { return _frames; }
+
+        void submit(const CommandList &commands) override {
+            write(uint32_t(commands.size()));
+            write(commands.viewCenter());
+            write(commands.viewSize());
+            for (const auto &command: commands) {
+                write(command.geometry);
+                write(command.position);
+                write(command.rotation);
+                write(command.scale);
+                write(command.fillColor);
+                write(command.outlineColor);
+                write(command.outlineThickness);
+                write(command.layer);
+                write(command.blend);
+            }
+            ++_frames;
+        }
+
+    private:
+        template<typename T>
+        void write(const T &value) {
+            _stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+    };
+
+    // Reads a recording back frame by frame
+    class RecordingReader {
+    private:
+        std::ifstream _stream;
+
+    public:
+        explicit RecordingReader(const std::string &path)
+        : _stream(path, std::ios::binary)
+        {
+            if (!_stream) throw std::runtime_error("Can not open the render recording " + path);
+
+            uint32_t magic = 0;
+            uint32_t version = 0;
+            read(magic);
+            read(version);
+            if (magic != recording::MAGIC || version != recording::VERSION) {
+                throw std::runtime_error("Unsupported render recording " + path);
+            }
+        }
+
+        // false once the recording is over
+        bool next(CommandList &commands) {
+            uint32_t count = 0;
+            sf::Vector2f viewCenter;
+            sf::Vector2f viewSize;
+            if (!read(count) || !read(viewCenter) || !read(viewSize)) return false;
+
+            commands.clear(viewCenter, viewSize);
+            for (uint32_t i = 0; i < count; ++i) {
+                RenderCommand command {};
+                read(command.geometry);
+                read(command.position);
+                read(command.rotation);
+                read(command.scale);
+                read(command.fillColor);
+                read(command.outlineColor);
+                read(command.outlineThickness);
+                read(command.layer);
+                if (!read(command.blend)) return false;
+                commands.add(command);
+            }
+            return true;
+        }
+
+    private:
+        template<typename T>
+        bool read(T &value) {
+            return bool(_stream.read(reinterpret_cast<char *>(&value), sizeof(T)));
+        }
+    };
+}
+
+#endif //RENDER_RECORDING_H
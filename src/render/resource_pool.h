@@ -0,0 +1,104 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef RENDER_RESOURCE_POOL_H
+#define RENDER_RESOURCE_POOL_H
+
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace render {
+
+    // Index of a slot and the generation it was created in, so a handle to a released slot does
+    // not reach whatever reused it. 0 is no resource.
+    struct ResourceHandle {
+        static constexpr uint32_t INDEX_BITS = 20;
+        static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+
+        uint32_t value = 0;
+
+        [[nodiscard]] uint32_t index() const { return value & INDEX_MASK; }
+
+        [[nodiscard]] uint32_t generation() const { return value >> INDEX_BITS; }
+
+        explicit operator bool() const { return value != 0; }
+
+        bool operator==(const ResourceHandle &handle) const { return value == handle.value; }
+
+        bool operator!=(const ResourceHandle &handle) const { return value != handle.value; }
+    };
+
+    // Slot map of resources of one type. The slots are reserved up front and reused after release,
+    // so creating a resource costs no allocation of its own until the capacity is exceeded.
+    template<typename T>
+    class ResourcePool {
+    private:
+        static constexpr uint32_t MAX_GENERATION = (1u << (32 - ResourceHandle::INDEX_BITS)) - 1;
+
+        struct Slot {
+            std::optional<T> value;
+            uint32_t generation = 1;
+        };
+
+        std::vector<Slot> _slots;
+        std::vector<uint32_t> _free;
+        size_t _size = 0;
+
+    public:
+        explicit ResourcePool(size_t capacity) {
+            _slots.reserve(capacity);
+            _free.reserve(capacity);
+        }
+
+        template<typename... Args>
+        ResourceHandle create(Args &&... args) {
+            uint32_t index;
+            if (!_free.empty()) {
+                index = _free.back();
+                _free.pop_back();
+            } else {
+                if (_slots.size() > ResourceHandle::INDEX_MASK) throw std::runtime_error("Resource pool is full");
+                index = uint32_t(_slots.size());
+                _slots.emplace_back();
+            }
+
+            auto &slot = _slots[index];
+            slot.value.emplace(std::forward<Args>(args)...);
+            ++_size;
+            return { slot.generation << ResourceHandle::INDEX_BITS | index };
+        }
+
+        [[nodiscard]] bool contains(const ResourceHandle &handle) const {
+            auto index = handle.index();
+            return handle && index < _slots.size() && _slots[index].value && _slots[index].generation == handle.generation();
+        }
+
+        T &get(const ResourceHandle &handle) {
+            if (!contains(handle)) throw std::runtime_error("No resource for the handle");
+            return *_slots[handle.index()].value;
+        }
+
+        const T &get(const ResourceHandle &handle) const {
+            if (!contains(handle)) throw std::runtime_error("No resource for the handle");
+            return *_slots[handle.index()].value;
+        }
+
+        void release(const ResourceHandle &handle) {
+            if (!contains(handle)) throw std::runtime_error("No resource for the handle");
+
+            auto &slot = _slots[handle.index()];
+            slot.value.reset();
+            // a slot that ran out of generations is retired, old handles can not match it again
+            if (slot.generation++ < MAX_GENERATION) _free.push_back(handle.index());
+            --_size;
+        }
+
+        [[nodiscard]] size_t size() const { return _size; }
+    };
+}
+
+#endif //RENDER_RESOURCE_POOL_H
@@ -0,0 +1,45 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef RENDER_SFML_BACKEND_H
+#define RENDER_SFML_BACKEND_H
+
+#include <SFML/Graphics.hpp>
+
+#include "backend.h"
+#include "shape_batch.h"
+#include "../utils/job_system.h"
+
+namespace render {
+
+    // Draws the frames to an SFML target, one fill and one outline batch per render state
+    class SfmlBackend : public IBackend {
+    private:
+        sf::RenderTarget &_target;
+        ShapeBatch _shapeBatch;
+
+    public:
+        // jobs - builds the vertices, the draw calls stay on the calling thread
+        SfmlBackend(sf::RenderTarget &target, const GeometryLibrary &geometries, JobSystem &jobs)
+        : _target(target)
+        , _shapeBatch(geometries, jobs)
+        {
+        }
+
+        void submit(const CommandList &commands) override {
+            _target.setView(sf::View(commands.viewCenter(), commands.viewSize()));
+
+            for (size_t begin = 0, end = 0; begin < commands.size(); begin = end) {
+                end = commands.stateEnd(begin);
+
+                _shapeBatch.build(commands, begin, end);
+                _shapeBatch.draw(_target, sf::RenderStates(commands[begin].blend == Blend::Add ? sf::BlendAdd : sf::BlendAlpha));
+            }
+
+            _target.setView(_target.getDefaultView());
+        }
+    };
+}
+
+#endif //RENDER_SFML_BACKEND_H
@@ -0,0 +1,145 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef RENDER_SHAPE_BATCH_H
+#define RENDER_SHAPE_BATCH_H
+
+#include <algorithm>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include "command_list.h"
+#include "geometry_library.h"
+#include "../utils/job_system.h"
+
+namespace render {
+
+    // Collects the fills and the outlines of many shapes into two triangle lists, transformed on the
+    // CPU, so the whole set costs two draw calls.
+    //
+    // The vertex count of every shape is known from its geometry, so a prefix sum gives each command
+    // its own slice of the two arrays up front. The arrays are then filled by the job system, every
+    // job writing a contiguous run of commands into its slices, and only the draw stays on the
+    // calling thread.
+    class ShapeBatch {
+    private:
+        // smaller runs cost more to hand to a worker than to transform
+        static constexpr size_t MIN_COMMANDS_PER_JOB = 128;
+
+        struct Slice {
+            uint32_t fill;
+            uint32_t outline;
+        };
+
+        const GeometryLibrary &_geometries;
+        JobSystem &_jobs;
+
+        sf::VertexArray _fills { sf::Triangles };
+        sf::VertexArray _outlines { sf::Triangles };
+
+        std::vector<Slice> _slices;
+
+    public:
+        ShapeBatch(const GeometryLibrary &geometries, JobSystem &jobs)
+        : _geometries(geometries)
+        , _jobs(jobs)
+        {
+        }
+
+        // Replaces the content with the commands [begin, end), every one of them transformed by
+        // base first. The vertex storage is kept, so a frame of the same size does not allocate.
+        void build(const CommandList &commands, size_t begin, size_t end, const sf::Transform &base = sf::Transform::Identity) {
+            auto count = end - begin;
+            _slices.resize(count + 1);
+
+            Slice total { 0, 0 };
+            for (size_t i = 0; i < count; ++i) {
+                _slices[i] = total;
+                const auto &command = commands[begin + i];
+                auto points = _geometries.geometry(command.geometry).count;
+                if (points < 3) continue;
+
+                if (command.fillColor.a != 0) total.fill += 3 * (points - 2);
+                if (command.outlineThickness != 0 && command.outlineColor.a != 0) total.outline += 6 * points;
+            }
+            _slices[count] = total;
+
+            _fills.resize(total.fill);
+            _outlines.resize(total.outline);
+
+            auto jobs = std::min(_jobs.size() * 4, (count + MIN_COMMANDS_PER_JOB - 1) / MIN_COMMANDS_PER_JOB);
+            _jobs.parallelFor(jobs, [&](size_t job) {
+                auto first = count * job / jobs;
+                auto last = count * (job + 1) / jobs;
+                for (auto i = first; i < last; ++i) {
+                    const auto &command = commands[begin + i];
+                    auto transform = base;
+                    transform.combine(command.transform());
+                    write(command, transform, _slices[i], _slices[i + 1]);
+                }
+            });
+        }
+
+        // triangles, every three vertices make one
+        [[nodiscard]] const sf::VertexArray &fills() const { return _fills; }
+
+        [[nodiscard]] const sf::VertexArray &outlines() const { return _outlines; }
+
+        void draw(sf::RenderTarget &target, const sf::RenderStates &states = sf::RenderStates::Default) const {
+            if (_fills.getVertexCount() > 0) target.draw(_fills, states);
+            if (_outlines.getVertexCount() > 0) target.draw(_outlines, states);
+        }
+
+    private:
+        void write(const RenderCommand &command, const sf::Transform &transform, const Slice &slice, const Slice &next) {
+            const auto *vertices = _geometries.vertices(command.geometry);
+            auto count = _geometries.geometry(command.geometry).count;
+
+            if (next.fill > slice.fill) {
+                writeFill(&_fills[slice.fill], vertices, count, transform, command.fillColor);
+            }
+            if (next.outline > slice.outline) {
+                writeOutline(&_outlines[slice.outline], vertices, count, transform, command.outlineColor, command.outlineThickness);
+            }
+        }
+
+        static void writeFill(sf::Vertex *out, const GeometryVertex *vertices, uint32_t count, const sf::Transform &transform, const sf::Color &color) {
+            // the shapes are convex, a fan around the first point covers them
+            auto first = transform.transformPoint(vertices[0].point);
+            auto previous = transform.transformPoint(vertices[1].point);
+            for (uint32_t i = 2; i < count; ++i) {
+                auto current = transform.transformPoint(vertices[i].point);
+                *out++ = { first, color };
+                *out++ = { previous, color };
+                *out++ = { current, color };
+                previous = current;
+            }
+        }
+
+        // thickness is in local space, same as the geometry
+        static void writeOutline(sf::Vertex *out, const GeometryVertex *vertices, uint32_t count, const sf::Transform &transform, const sf::Color &color, float thickness) {
+            const auto &last = vertices[count - 1];
+            auto previousInner = transform.transformPoint(last.point);
+            auto previousOuter = transform.transformPoint(last.point + last.extrude * thickness);
+            for (uint32_t i = 0; i < count; ++i) {
+                auto inner = transform.transformPoint(vertices[i].point);
+                auto outer = transform.transformPoint(vertices[i].point + vertices[i].extrude * thickness);
+
+                *out++ = { previousInner, color };
+                *out++ = { previousOuter, color };
+                *out++ = { inner, color };
+
+                *out++ = { inner, color };
+                *out++ = { previousOuter, color };
+                *out++ = { outer, color };
+
+                previousInner = inner;
+                previousOuter = outer;
+            }
+        }
+    };
+}
+
+#endif //RENDER_SHAPE_BATCH_H
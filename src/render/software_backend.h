@@ -0,0 +1,271 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef RENDER_SOFTWARE_BACKEND_H
+#define RENDER_SOFTWARE_BACKEND_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include "backend.h"
+#include "shape_batch.h"
+#include "../utils/job_system.h"
+
+namespace render {
+
+    // Rasterizes the frames on the CPU into an RGBA framebuffer, for machines without a display.
+    //
+    // The shapes are turned into the same triangles the SFML backend draws, already in screen
+    // space, and binned into square tiles by their bounds. The tiles are then filled in parallel,
+    // each by one thread, so no two threads ever touch the same pixel and a tile blends its
+    // triangles in submission order like the GPU would.
+    class SoftwareBackend : public IBackend {
+    private:
+        static constexpr int TILE_SIZE = 64;
+
+        struct Triangle {
+            sf::Vector2f a;
+            sf::Vector2f b;
+            sf::Vector2f c;
+            sf::Color color;
+            Blend blend;
+            int minX;
+            int minY;
+            int maxX;   // exclusive
+            int maxY;   // exclusive
+        };
+
+        JobSystem &_jobs;
+        ShapeBatch _shapeBatch;
+
+        int _width;
+        int _height;
+        int _columns;
+        int _rows;
+
+        std::vector<sf::Color> _pixels;
+        std::vector<Triangle> _triangles;
+        std::vector<std::vector<uint32_t>> _tiles;
+
+        uint _dumpEvery;
+        std::string _dumpPath;
+        uint _frame = 0;
+
+    public:
+        // dumpEvery - frames between two dumps of the framebuffer, 0 never dumps
+        // dumpPath - prefix of the dumped files, the frame number and .ppm are appended to it
+        SoftwareBackend(const GeometryLibrary &geometries, JobSystem &jobs, uint width, uint height,
+                        uint dumpEvery = 0, std::string dumpPath = "")
+        : _jobs(jobs)
+        , _shapeBatch(geometries, jobs)
+        , _width(int(width))
+        , _height(int(height))
+        , _columns((int(width) + TILE_SIZE - 1) / TILE_SIZE)
+        , _rows((int(height) + TILE_SIZE - 1) / TILE_SIZE)
+        , _pixels(size_t(width) * height)
+        , _tiles(size_t(_columns) * _rows)
+        , _dumpEvery(dumpEvery)
+        , _dumpPath(std::move(dumpPath))
+        {
+        }
+
+        [[nodiscard]] int width() const { return _width; }
+
+        [[nodiscard]] int height() const { return _height; }
+
+        [[nodiscard]] const std::vector<sf::Color> &pixels() const { return _pixels; }
+
+        void submit(const CommandList &commands) override {
+            // world to framebuffer pixels
+            sf::Transform view;
+            view.scale(float(_width) / commands.viewSize().x, float(_height) / commands.viewSize().y)
+                .translate(commands.viewSize() * 0.5f - commands.viewCenter());
+
+            // fills and outlines of a state go one after the other, same as in the SFML backend
+            _triangles.clear();
+            for (size_t begin = 0, end = 0; begin < commands.size(); begin = end) {
+                end = commands.stateEnd(begin);
+
+                _shapeBatch.build(commands, begin, end, view);
+                addTriangles(_shapeBatch.fills(), commands[begin].blend);
+                addTriangles(_shapeBatch.outlines(), commands[begin].blend);
+            }
+
+            bin();
+            _jobs.parallelFor(_tiles.size(), [this](size_t tile) { rasterizeTile(tile); });
+
+            ++_frame;
+            if (_dumpEvery > 0 && _frame % _dumpEvery == 0) {
+                char number[16];
+                std::snprintf(number, sizeof(number), "%06u", _frame);
+                writePpm(_dumpPath + number + ".ppm");
+            }
+        }
+
+        // binary PPM, the alpha channel is dropped
+        void writePpm(const std::string &path) const {
+            std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+            if (!stream) throw std::runtime_error("Can not write the frame " + path);
+
+            stream << "P6\n" << _width << " " << _height << "\n255\n";
+            std::vector<uint8_t> row(size_t(_width) * 3);
+            for (int y = 0; y < _height; ++y) {
+                for (int x = 0; x < _width; ++x) {
+                    const auto &pixel = _pixels[size_t(y) * _width + x];
+                    row[x * 3] = pixel.r;
+                    row[x * 3 + 1] = pixel.g;
+                    row[x * 3 + 2] = pixel.b;
+                }
+                stream.write(reinterpret_cast<const char *>(row.data()), std::streamsize(row.size()));
+            }
+        }
+
+    private:
+        void addTriangles(const sf::VertexArray &vertices, Blend blend) {
+            for (size_t i = 0; i + 2 < vertices.getVertexCount(); i += 3) {
+                const auto &a = vertices[i].position;
+                const auto &b = vertices[i + 1].position;
+                const auto &c = vertices[i + 2].position;
+
+                // pixels whose centers may be covered
+                Triangle triangle {
+                        a,
+                        b,
+                        c,
+                        vertices[i].color,
+                        blend,
+                        std::max(0, int(std::floor(std::min({ a.x, b.x, c.x }) - 0.5f))),
+                        std::max(0, int(std::floor(std::min({ a.y, b.y, c.y }) - 0.5f))),
+                        std::min(_width, int(std::ceil(std::max({ a.x, b.x, c.x }) + 0.5f))),
+                        std::min(_height, int(std::ceil(std::max({ a.y, b.y, c.y }) + 0.5f)))
+                };
+
+                if (triangle.minX < triangle.maxX && triangle.minY < triangle.maxY) {
+                    _triangles.push_back(triangle);
+                }
+            }
+        }
+
+        // keeps the bin storage between frames
+        void bin() {
+            for (auto &tile: _tiles) tile.clear();
+
+            for (uint32_t i = 0; i < _triangles.size(); ++i) {
+                const auto &triangle = _triangles[i];
+                for (auto row = triangle.minY / TILE_SIZE; row <= (triangle.maxY - 1) / TILE_SIZE; ++row) {
+                    for (auto column = triangle.minX / TILE_SIZE; column <= (triangle.maxX - 1) / TILE_SIZE; ++column) {
+                        _tiles[size_t(row) * _columns + column].push_back(i);
+                    }
+                }
+            }
+        }
+
+        void rasterizeTile(size_t tile) {
+            auto tileX = int(tile % _columns) * TILE_SIZE;
+            auto tileY = int(tile / _columns) * TILE_SIZE;
+            auto tileRight = std::min(tileX + TILE_SIZE, _width);
+            auto tileBottom = std::min(tileY + TILE_SIZE, _height);
+
+            for (auto y = tileY; y < tileBottom; ++y) {
+                std::fill(_pixels.begin() + y * _width + tileX, _pixels.begin() + y * _width + tileRight, sf::Color::Black);
+            }
+
+            for (auto index: _tiles[tile]) {
+                const auto &triangle = _triangles[index];
+                rasterize(triangle,
+                          std::max(triangle.minX, tileX), std::max(triangle.minY, tileY),
+                          std::min(triangle.maxX, tileRight), std::min(triangle.maxY, tileBottom));
+            }
+        }
+
+        // Edge functions sampled at the pixel centers, the top-left rule keeps pixels on an edge
+        // shared by two triangles from being blended twice.
+        void rasterize(const Triangle &triangle, int minX, int minY, int maxX, int maxY) {
+            auto a = triangle.a;
+            auto b = triangle.b;
+            auto c = triangle.c;
+            auto area = edge(a, b, c);
+            if (area == 0) return;
+            if (area < 0) std::swap(b, c);
+
+            auto biasBC = isTopLeft(b, c) ? 0.f : -1e-6f;
+            auto biasCA = isTopLeft(c, a) ? 0.f : -1e-6f;
+            auto biasAB = isTopLeft(a, b) ? 0.f : -1e-6f;
+
+            // how the edge functions change per pixel step
+            auto stepXBC = b.y - c.y, stepYBC = c.x - b.x;
+            auto stepXCA = c.y - a.y, stepYCA = a.x - c.x;
+            auto stepXAB = a.y - b.y, stepYAB = b.x - a.x;
+
+            auto start = sf::Vector2f(float(minX) + 0.5f, float(minY) + 0.5f);
+            auto rowBC = edge(b, c, start);
+            auto rowCA = edge(c, a, start);
+            auto rowAB = edge(a, b, start);
+
+            for (auto y = minY; y < maxY; ++y) {
+                auto wBC = rowBC, wCA = rowCA, wAB = rowAB;
+                auto *pixel = _pixels.data() + size_t(y) * _width + minX;
+                for (auto x = minX; x < maxX; ++x, ++pixel) {
+                    if (wBC + biasBC >= 0 && wCA + biasCA >= 0 && wAB + biasAB >= 0) {
+                        if (triangle.blend == Blend::Add) {
+                            add(*pixel, triangle.color);
+                        } else {
+                            blend(*pixel, triangle.color);
+                        }
+                    }
+                    wBC += stepXBC;
+                    wCA += stepXCA;
+                    wAB += stepXAB;
+                }
+                rowBC += stepYBC;
+                rowCA += stepYCA;
+                rowAB += stepYAB;
+            }
+        }
+
+        // twice the signed area of the triangle a, b, p, positive when p is on the inner side of a -> b
+        static float edge(const sf::Vector2f &a, const sf::Vector2f &b, const sf::Vector2f &p) {
+            return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+        }
+
+        // with y pointing down and the edges going clockwise, a top edge is horizontal and goes right,
+        // a left edge goes up
+        static bool isTopLeft(const sf::Vector2f &from, const sf::Vector2f &to) {
+            return (from.y == to.y && to.x > from.x) || to.y < from.y;
+        }
+
+        // source over, the same as sf::BlendAlpha
+        static void blend(sf::Color &destination, const sf::Color &source) {
+            if (source.a == 255) {
+                destination = source;
+                return;
+            }
+            auto alpha = uint32_t(source.a);
+            auto inverse = 255 - alpha;
+            destination.r = uint8_t((source.r * alpha + destination.r * inverse + 127) / 255);
+            destination.g = uint8_t((source.g * alpha + destination.g * inverse + 127) / 255);
+            destination.b = uint8_t((source.b * alpha + destination.b * inverse + 127) / 255);
+            destination.a = uint8_t(alpha + (destination.a * inverse + 127) / 255);
+        }
+
+        // the same as sf::BlendAdd
+        static void add(sf::Color &destination, const sf::Color &source) {
+            auto alpha = uint32_t(source.a);
+            destination.r = uint8_t(std::min<uint32_t>(destination.r + (source.r * alpha + 127) / 255, 255));
+            destination.g = uint8_t(std::min<uint32_t>(destination.g + (source.g * alpha + 127) / 255, 255));
+            destination.b = uint8_t(std::min<uint32_t>(destination.b + (source.b * alpha + 127) / 255, 255));
+            destination.a = uint8_t(std::min<uint32_t>(destination.a + alpha, 255));
+        }
+    };
+}
+
+#endif //RENDER_SOFTWARE_BACKEND_H
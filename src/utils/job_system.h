@@ -0,0 +1,121 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+
+#ifndef INTROECS_JOB_SYSTEM_H
+#define INTROECS_JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed set of worker threads that split an indexed batch of jobs with the calling thread.
+// Workers are started once and sleep between batches, so a batch costs a wake-up and no allocation.
+class JobSystem {
+private:
+    std::vector<std::thread> _workers;
+
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+
+    void *_job = nullptr;
+    void (*_invoke)(void *, size_t) = nullptr;
+    size_t _count = 0;
+    uint64_t _generation = 0;
+    size_t _active = 0;
+    bool _stop = false;
+
+    std::atomic<size_t> _next = 0;
+    std::atomic<size_t> _remaining = 0;
+
+public:
+    // threads - total number of threads running a batch including the caller
+    explicit JobSystem(size_t threads = std::thread::hardware_concurrency()) {
+        for (size_t i = 1; i < threads; ++i) {
+            _workers.emplace_back([this]() { work(); });
+        }
+    }
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    ~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for (auto &worker: _workers) {
+            worker.join();
+        }
+    }
+
+    [[nodiscard]] size_t size() const { return _workers.size() + 1; }
+
+    // Calls fn(index) for every index in [0, count) and returns when all of them are done.
+    template<typename Fn>
+    void parallelFor(size_t count, Fn &&fn) {
+        if (count == 0) return;
+        if (_workers.empty() || count == 1) {
+            for (size_t i = 0; i < count; ++i) fn(i);
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        // a worker late for the previous batch may still be reading it
+        _done.wait(lock, [this]() { return _active == 0; });
+
+        _job = &fn;
+        _invoke = [](void *job, size_t index) { (*static_cast<std::remove_reference_t<Fn> *>(job))(index); };
+        _count = count;
+        _next = 0;
+        _remaining = count;
+        ++_generation;
+
+        lock.unlock();
+        _wake.notify_all();
+
+        drain();
+
+        lock.lock();
+        _done.wait(lock, [this]() { return _remaining == 0 && _active == 0; });
+        _job = nullptr;
+        _invoke = nullptr;
+    }
+
+private:
+    void work() {
+        uint64_t generation = 0;
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            _wake.wait(lock, [this, generation]() { return _stop || _generation != generation; });
+            if (_stop) return;
+
+            generation = _generation;
+            ++_active;
+            lock.unlock();
+
+            drain();
+
+            lock.lock();
+            if (--_active == 0) _done.notify_all();
+        }
+    }
+
+    void drain() {
+        for (auto index = _next++; index < _count; index = _next++) {
+            _invoke(_job, index);
+            if (--_remaining == 0) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _done.notify_all();
+            }
+        }
+    }
+};
+
+#endif //INTROECS_JOB_SYSTEM_H
@@ -0,0 +1,132 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+#include <SFML/Graphics.hpp>
+#include <cstdio>
+#include <memory>
+
+#include "../src/ecs/systems.h"
+#include "../src/game/components/components.h"
+#include "../src/game/config/config.h"
+#include "../src/game/geometries.h"
+#include "../src/game/systems/collide_system.h"
+#include "../src/game/systems/move_system.h"
+#include "../src/game/systems/shoot_player_system.h"
+#include "../src/game/systems/update_spatial_index_system.h"
+#include "../src/physics/contact.h"
+#include "../src/physics/spatial_index.h"
+#include "../src/utils/job_system.h"
+
+// unlike assert, stays in release builds
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            return false; \
+        } \
+    } while (false)
+
+namespace {
+
+    // the systems the projectiles and the collisions of a frame go through, in the order of the game
+    struct Physics {
+        Config config {};
+        Geometries geometries;
+        ecs::Prefab projectile { "Projectile" };
+        physics::SpatialIndex spatialIndex;
+        physics::Contacts contacts;
+        JobSystem jobs { 1 };
+        ecs::Systems systems;
+
+        Physics()
+        : systems(ecs::Systems::builder()
+                .add(std::make_shared<ShootPlayerSystem>(config, geometries, projectile))
+                .add(std::make_shared<MoveSystem>())
+                .add(std::make_shared<UpdateSpatialIndexSystem>(config, spatialIndex))
+                .add(std::make_shared<CollideSystem>(spatialIndex, contacts, jobs))
+                .build())
+        {
+            config.world = { 2400, 1800 };
+            config.player.radius = 15;
+            config.player.shootCooldown = 10;
+            config.projectile = { 3, 8, 60, Color() };
+
+            // as in res/prefabs.ini
+            projectile.with<CProjectileTag>()
+                    .with(CTransform(Vector2(0, 0)))
+                    .with<CGeometry>()
+                    .with<CVelocity>()
+                    .with(CCollider { 0 })
+                    .with(CLifespan(0))
+                    .recycled();
+        }
+
+        void frame(ecs::World &world) {
+            systems.run(world, sf::Time());
+        }
+    };
+
+    ecs::Entity spawn(ecs::World &world, const Vector2 &position, float radius, const Vector2 &velocity = Vector2()) {
+        auto entity = world.newEntity();
+        world.pool<CTransform>()->add(entity, CTransform(position));
+        world.pool<CCollider>()->add(entity, { radius });
+        if (velocity.sqrMagnitude() > 0) world.pool<CVelocity>()->add(entity, CVelocity(velocity));
+        return entity;
+    }
+
+    // A projectile starts at the nose of the ship, closer to its center than the two radii, and
+    // is first indexed after its first move. It is clear of the ship then and must not hit it on
+    // the way out.
+    bool projectileDoesNotHitItsShip() {
+        ecs::World world;
+        Physics physics;
+        physics.systems.init(world);
+
+        auto ship = spawn(world, Vector2(1200, 900), 15);
+        world.pool<CPlayerTag>()->add(ship);
+        world.pool<CInput>()->add(ship);
+        world.pool<CInput>()->write(ship).shoot = true;
+        world.update();
+
+        // shoots, the projectile joins the filters at the end of the frame
+        physics.frame(world);
+        CHECK(physics.contacts.empty());
+        CHECK(world.entities().size() == 2);
+
+        for (int frame = 0; frame < 2; ++frame) {
+            physics.frame(world);
+            CHECK(physics.contacts.empty());
+        }
+        return true;
+    }
+
+    // past its first tick a fast projectile is still swept and can not tunnel through small things
+    bool fastProjectileDoesNotTunnel() {
+        ecs::World world;
+        Physics physics;
+        physics.systems.init(world);
+
+        auto projectile = spawn(world, Vector2(1200, 885), 3, Vector2(0, -8));
+        world.update();
+        physics.frame(world);
+        CHECK(physics.contacts.empty());
+
+        // halfway between where the projectile is and where it will be after the next move
+        auto target = spawn(world, Vector2(1200, 873), 0.5f);
+        world.update();
+        physics.frame(world);
+        CHECK(physics.contacts.size() == 1);
+
+        const auto &contact = *physics.contacts.begin();
+        CHECK(contact.other(projectile) == target);
+        return true;
+    }
+}
+
+int main() {
+    bool passed = true;
+    passed &= projectileDoesNotHitItsShip();
+    passed &= fastProjectileDoesNotTunnel();
+    std::puts(passed ? "passed" : "failed");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,218 @@
+//
+// Created by Anton Kukhlevskyi on 2026-10-19.
+//
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include "../src/ecs/world.h"
+
+// unlike assert, stays in release builds
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            return false; \
+        } \
+    } while (false)
+
+namespace {
+
+    struct CValue { int value = 1; };
+    struct CPosition { float x = 0; float y = 0; };
+    struct CTag {};
+}
+
+namespace ecs {
+    template <>
+    struct SoaLayout<CPosition> {
+        static constexpr bool ENABLED = true;
+        static constexpr size_t COLUMNS = 2;
+
+        struct Ref {
+            float& x;
+            float& y;
+        };
+
+        static void store(const CPosition& position, Columns<COLUMNS>& columns, size_t index) {
+            columns[0][index] = position.x;
+            columns[1][index] = position.y;
+        }
+
+        static CPosition load(const Columns<COLUMNS>& columns, size_t index) {
+            return { columns[0][index], columns[1][index] };
+        }
+
+        static Ref ref(Columns<COLUMNS>& columns, size_t index) {
+            return { columns[0][index], columns[1][index] };
+        }
+    };
+}
+
+namespace {
+
+    // Entities come and go every frame the way they do in the game: one by one, from prefabs,
+    // recycled, with components removed on their own. Once the first frames warmed the world up
+    // its bookkeeping, the filters and the pools must not allocate anymore.
+    bool steadyFramesDoNotAllocate() {
+        ecs::World world(64);
+        auto values = world.pool<CValue>();
+        auto positions = world.pool<CPosition>();
+        auto tags = world.pool<CTag>();
+        auto filter = world.buildFilter().include<CValue>().exclude<CTag>().build();
+        auto moving = world.buildFilter().include<CPosition>().build();
+        size_t removed = 0;
+        world.onRemove<CValue>([&removed](const ecs::Entities& entities) { removed += entities.size(); });
+
+        ecs::Prefab recycled("recycled");
+        recycled.with<CValue>().with<CPosition>().recycled();
+        ecs::Prefab tagged("tagged");
+        tagged.with<CValue>().with<CTag>();
+
+        ecs::Entities alive;
+        alive.reserve(64);
+        auto frame = [&](int i) {
+            auto entity = world.newEntity();
+            values->add(entity, { i });
+            positions->add(entity, { float(i), 0 });
+            if (i % 2) tags->add(entity);
+            world.instantiate(recycled, 3, [](const ecs::Entity&, size_t) {});
+            world.instantiate(tagged, 2, [](const ecs::Entity&, size_t) {});
+            world.update();
+
+            positions->del(entity);
+            world.update();
+
+            alive.assign(world.entities().begin(), world.entities().end());
+            for (auto other : alive) world.deleteEntity(other);
+            world.update();
+        };
+
+        for (int i = 0; i < 10; ++i) frame(i);
+        CHECK(filter->entities().empty());
+        CHECK(moving->entities().empty());
+
+        auto warm = ecs::World::allocations();
+        for (int i = 0; i < 1000; ++i) frame(i);
+        CHECK(ecs::World::allocations() == warm);
+        CHECK(removed > 0);
+        return true;
+    }
+
+    // a removed component leaves a hole the last one is moved into, the others keep their values
+    bool removedComponentsKeepTheOthers() {
+        ecs::World world(8);
+        auto values = world.pool<CValue>();
+        auto positions = world.pool<CPosition>();
+
+        std::vector<ecs::Entity> entities;
+        for (int i = 0; i < 5; ++i) {
+            auto entity = world.newEntity();
+            values->add(entity, { i });
+            positions->add(entity, { float(i), float(-i) });
+            entities.push_back(entity);
+        }
+        world.update();
+
+        values->del(entities[1]);
+        positions->del(entities[0]);
+        world.deleteEntity(entities[2]);
+        world.update();
+
+        CHECK(!values->has(entities[1]) && positions->has(entities[1]));
+        CHECK(values->has(entities[0]) && !positions->has(entities[0]));
+        CHECK(!values->has(entities[2]) && !positions->has(entities[2]));
+        CHECK(std::as_const(*values).get(entities[0]).value == 0);
+        for (int i = 3; i < 5; ++i) {
+            CHECK(std::as_const(*values).get(entities[i]).value == i);
+            CHECK(std::as_const(*positions).get(entities[i]).y == float(-i));
+        }
+        CHECK(std::as_const(*positions).get(entities[1]).x == 1.f);
+        return true;
+    }
+
+    // a system sees the components added and written since its own last run, reads do not count
+    bool changeFiltersSeeWritesOnly() {
+        ecs::World world(8);
+        auto values = world.pool<CValue>();
+        auto positions = world.pool<CPosition>();
+        auto changed = world.buildFilter().changed<CValue>().build();
+        auto added = world.buildFilter().added<CPosition>().include<CValue>().build();
+
+        auto first = world.newEntity();
+        auto second = world.newEntity();
+        values->add(first);
+        values->add(second);
+        positions->add(first);
+        world.update();
+
+        ecs::Tick lastRun = 0;
+        // runs the checks as a system, false if one of them failed
+        auto run = [&world, &lastRun](auto&& system) {
+            lastRun = world.beginSystem(lastRun);
+            auto passed = system();
+            world.endSystem();
+            return passed;
+        };
+
+        CHECK(run([&] { CHECK(changed->entities().size() == 2 && added->entities().size() == 1); return true; }));
+        CHECK(run([&] { CHECK(changed->entities().empty() && added->entities().empty()); return true; }));
+
+        // outside of the system
+        values->get(first).value = 2;
+        values->write(second).value = 3;
+        positions->add(second);
+        world.update();
+        CHECK(run([&] {
+            CHECK(changed->entities().size() == 1 && changed->entities()[0] == second);
+            CHECK(added->entities().size() == 1 && added->entities()[0] == second);
+            return true;
+        }));
+
+        values->get(first).value = 4;
+        values->markChanged(first);
+        CHECK(run([&] { CHECK(changed->entities().size() == 1 && changed->entities()[0] == first); return true; }));
+        return true;
+    }
+
+    // remove observers read the components however they went away, removed by del or deleted
+    bool removeObserversReadTheValues() {
+        ecs::World world(8);
+        auto values = world.pool<CValue>();
+        std::vector<int> released;
+        world.onRemove<CValue>([&values, &released](const ecs::Entities& entities) {
+            for (const auto& entity : entities) released.push_back(std::as_const(*values).get(entity).value);
+        });
+
+        auto removed = world.newEntity();
+        auto deleted = world.newEntity();
+        auto readded = world.newEntity();
+        values->add(removed, { 1 });
+        values->add(deleted, { 2 });
+        values->add(readded, { 3 });
+        world.update();
+
+        values->del(removed);
+        values->del(readded);
+        CHECK(!values->has(removed) && !values->has(readded));
+        values->add(readded, { 4 });
+        world.deleteEntity(deleted);
+        world.update();
+
+        CHECK(released.size() == 2);
+        CHECK((released[0] == 1 && released[1] == 2) || (released[0] == 2 && released[1] == 1));
+        CHECK(!values->has(removed) && values->has(readded));
+        CHECK(std::as_const(*values).get(readded).value == 4);
+        return true;
+    }
+}
+
+int main() {
+    bool passed = true;
+    passed &= steadyFramesDoNotAllocate();
+    passed &= removedComponentsKeepTheOthers();
+    passed &= changeFiltersSeeWritesOnly();
+    passed &= removeObserversReadTheValues();
+    std::puts(passed ? "passed" : "failed");
+    return passed ? 0 : 1;
+}